@@ -0,0 +1,1039 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include "collision_benchmark.h"
+
+#include "collision_reference.h"
+#include "collisions.h"
+#include "map.h"
+#include "obstacle_store.h"
+#include "object_transform.h"
+#include "transform_graph.h"
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// the player cylinder used by the examples
+constexpr float PlayerRadius = 1.5f;
+constexpr float PlayerHeight = 2.0f;
+
+// how far the player gets in one simulation step at full speed
+constexpr float PathStepLength = 0.5f;
+
+// the third person camera sits this far back from the top of the player
+constexpr float CameraRadius = 0.25f;
+constexpr float CameraPullback = 10.0f;
+
+// the small collision tests are over in a few nanoseconds, so they get more queries
+constexpr int KernelQueryScale = 10;
+
+// the cold inputs for the small collision tests are much bigger than the caches, the hot ones fit in a few cache lines
+constexpr int ColdKernelInputs = 1 << 19;
+constexpr int HotKernelInputs = 64;
+
+// reading the clock costs about as much as a small collision test, so those are timed in groups
+// and each query in a group gets the group average
+constexpr int KernelQueriesPerSample = 64;
+constexpr int RaysPerBatch = 256;
+
+// how many nodes of the transform hierarchy move each frame
+constexpr int TransformMovesPerFrame = 500;
+
+// how far a player may overlap a wall after a move before it counts as inside it
+constexpr float OverlapTolerance = 0.01f;
+
+// results may differ from the reference by float error only
+constexpr float ResultTolerance = 0.001f;
+
+// a sphere coming at a wall head on moves twice the tolerance when the radius changes by it, one that grazes a wall moves much further
+constexpr float GrazingSphereTolerance = ResultTolerance * 10;
+
+// one step along a player path, the gun ray points the way the player is walking
+struct PathQuery
+{
+    Vector3 Position = { 0 };
+    Vector3 Movement = { 0 };
+    Ray GunRay = { 0 };
+    Ray CameraRay = { 0 };
+};
+
+// the inputs for the small collision tests, the cylinder is in the space of the wall and in world space
+struct KernelInput
+{
+    int Wall = 0;
+    Vector3 Center = { 0 };
+    Vector3 OldCenter = { 0 };
+    Vector3 WorldCenter = { 0 };
+    Vector3 WorldOldCenter = { 0 };
+    Ray WorldRay = { 0 };
+
+    // a player sized box turned any which way, overlapping the wall or near it
+    OrientedBox Box;
+};
+
+struct KernelResult
+{
+    bool Hit = false;
+    Vector3 Point = { 0 };
+    Vector3 Normal = { 0 };
+};
+
+// the time for each sample is stored per query, in nanoseconds
+struct QueryTimes
+{
+    double Seconds = 0;
+    int Queries = 0;
+    std::vector<float> Samples;
+};
+
+static float RandomFloat(float min, float max)
+{
+    return min + (max - min) * (GetRandomValue(0, 100000) / 100000.0f);
+}
+
+static Vector3 RandomFieldPoint(const CollisionBenchmarkOptions& options, float y)
+{
+    float halfSize = options.FieldSize * 0.5f;
+    return Vector3{ RandomFloat(-halfSize, halfSize), y, RandomFloat(-halfSize, halfSize) };
+}
+
+static std::vector<int> ShuffledOrder(int count)
+{
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++)
+        order[i] = i;
+
+    for (int i = count - 1; i > 0; i--)
+        std::swap(order[i], order[GetRandomValue(0, i)]);
+
+    return order;
+}
+
+// how deep the player cylinder is inside a wall on the XZ plane, worked out directly from the wall box
+static float PlayerWallDepth(const OrientedBox& box, Vector3 position, float radius, float height)
+{
+    if (position.y >= box.Center.y + box.HalfExtents.y || position.y + height <= box.Center.y - box.HalfExtents.y)
+        return 0;
+
+    Vector3 offset = Vector3Subtract(position, box.Center);
+    float x = Vector3DotProduct(offset, box.Axes[0]);
+    float z = Vector3DotProduct(offset, box.Axes[2]);
+
+    float outsideX = fabsf(x) - box.HalfExtents.x;
+    float outsideZ = fabsf(z) - box.HalfExtents.z;
+
+    // a center inside the box has to get past the nearest side
+    if (outsideX <= 0 && outsideZ <= 0)
+        return radius - std::max(outsideX, outsideZ);
+
+    float distance = sqrtf(std::max(outsideX, 0.0f) * std::max(outsideX, 0.0f) + std::max(outsideZ, 0.0f) * std::max(outsideZ, 0.0f));
+    return std::max(radius - distance, 0.0f);
+}
+
+static float PlayerMapDepth(Map& map, Vector3 position, float radius, float height)
+{
+    float depth = 0;
+    for (Obstacle& wall : map.Walls)
+        depth = std::max(depth, PlayerWallDepth(wall.GetWorldBox(), position, radius, height));
+
+    return depth;
+}
+
+// how far a point is from the nearest wall
+static float MapDistance(Map& map, Vector3 point)
+{
+    float distance = std::numeric_limits<float>::max();
+    for (Obstacle& wall : map.Walls)
+    {
+        const OrientedBox& box = wall.GetWorldBox();
+        Vector3 offset = Vector3Subtract(point, box.Center);
+
+        float halfExtents[3] = { box.HalfExtents.x, box.HalfExtents.y, box.HalfExtents.z };
+        float outside[3] = { 0 };
+        for (int axis = 0; axis < 3; axis++)
+            outside[axis] = std::max(fabsf(Vector3DotProduct(offset, box.Axes[axis])) - halfExtents[axis], 0.0f);
+
+        distance = std::min(distance, sqrtf(outside[0] * outside[0] + outside[1] * outside[1] + outside[2] * outside[2]));
+    }
+
+    return distance;
+}
+
+static void GetOrientedBoxCorners(const OrientedBox& box, Vector3 corners[8])
+{
+    for (int i = 0; i < 8; i++)
+    {
+        Vector3 corner = box.Center;
+        corner = Vector3Add(corner, Vector3Scale(box.Axes[0], (i & 1) ? box.HalfExtents.x : -box.HalfExtents.x));
+        corner = Vector3Add(corner, Vector3Scale(box.Axes[1], (i & 2) ? box.HalfExtents.y : -box.HalfExtents.y));
+        corner = Vector3Add(corner, Vector3Scale(box.Axes[2], (i & 4) ? box.HalfExtents.z : -box.HalfExtents.z));
+        corners[i] = corner;
+    }
+}
+
+// how far two oriented boxes overlap, negative when they are apart, the slow way
+// every corner is projected onto each of the 15 axes that can separate two boxes, and the smallest overlap of the ranges is kept
+static float OrientedBoxOverlap(const OrientedBox& box1, const OrientedBox& box2)
+{
+    Vector3 corners1[8];
+    Vector3 corners2[8];
+    GetOrientedBoxCorners(box1, corners1);
+    GetOrientedBoxCorners(box2, corners2);
+
+    std::vector<Vector3> axes;
+    for (int i = 0; i < 3; i++)
+    {
+        axes.push_back(box1.Axes[i]);
+        axes.push_back(box2.Axes[i]);
+
+        // parallel edges make no axis, those boxes are separated by a face axis if they are separated at all
+        for (int j = 0; j < 3; j++)
+        {
+            Vector3 cross = Vector3CrossProduct(box1.Axes[i], box2.Axes[j]);
+            if (Vector3Length(cross) > 0.001f)
+                axes.push_back(Vector3Normalize(cross));
+        }
+    }
+
+    float overlap = std::numeric_limits<float>::max();
+    for (const Vector3& axis : axes)
+    {
+        float min1 = std::numeric_limits<float>::max();
+        float max1 = -std::numeric_limits<float>::max();
+        float min2 = std::numeric_limits<float>::max();
+        float max2 = -std::numeric_limits<float>::max();
+        for (int i = 0; i < 8; i++)
+        {
+            min1 = std::min(min1, Vector3DotProduct(corners1[i], axis));
+            max1 = std::max(max1, Vector3DotProduct(corners1[i], axis));
+            min2 = std::min(min2, Vector3DotProduct(corners2[i], axis));
+            max2 = std::max(max2, Vector3DotProduct(corners2[i], axis));
+        }
+
+        overlap = std::min(overlap, std::min(max1, max2) - std::max(min1, min2));
+    }
+
+    return overlap;
+}
+
+// march a sphere along a ray by the distance to the nearest wall until it touches one, the slow way to cast a sphere
+static float TraceSphere(Map& map, Ray ray, float radius, float maxDistance)
+{
+    constexpr float touching = 0.0001f;
+
+    float distance = 0;
+    for (int step = 0; step < 1000 && distance < maxDistance; step++)
+    {
+        float gap = MapDistance(map, Vector3Add(ray.position, Vector3Scale(ray.direction, distance))) - radius;
+        if (gap < touching)
+            return distance;
+
+        distance += gap;
+    }
+
+    return maxDistance;
+}
+
+static void BuildBenchmarkMap(Map& map, const CollisionBenchmarkOptions& options)
+{
+    BuildDemoMap(map);
+
+    for (int i = 0; i < options.Walls; i++)
+    {
+        Vector3 center = RandomFieldPoint(options, 0);
+        map.Walls.emplace_back(center.x, center.z, RandomFloat(0.5f, 4), RandomFloat(2, 6), RandomFloat(2, 20), RandomFloat(-180, 180));
+    }
+
+    map.WallsChanged();
+}
+
+// players start somewhere clear and wander, turning a little each step, moving the way the game would move them
+static std::vector<PathQuery> BuildPaths(Map& map, const CollisionBenchmarkOptions& options)
+{
+    std::vector<PathQuery> queries;
+    queries.reserve(options.Queries);
+
+    while (int(queries.size()) < options.Queries)
+    {
+        Vector3 position = RandomFieldPoint(options, 0);
+        if (PlayerMapDepth(map, position, PlayerRadius, PlayerHeight) > 0)
+            continue;
+
+        float heading = RandomFloat(0, PI * 2);
+        for (int step = 0; step < options.PathLength && int(queries.size()) < options.Queries; step++)
+        {
+            heading += RandomFloat(-0.2f, 0.2f);
+
+            PathQuery query;
+            query.Position = position;
+            query.Movement = Vector3{ cosf(heading) * PathStepLength, 0, sinf(heading) * PathStepLength };
+            query.GunRay.position = Vector3Add(position, Vector3{ 0, 1.5f, 0 });
+            query.GunRay.direction = Vector3Normalize(Vector3{ cosf(heading), RandomFloat(-0.1f, 0.1f), sinf(heading) });
+            query.CameraRay.position = Vector3Add(position, Vector3{ 0, PlayerHeight, 0 });
+            query.CameraRay.direction = Vector3Normalize(Vector3{ -cosf(heading), 0.3f, -sinf(heading) });
+            queries.push_back(query);
+
+            Vector3 newPosition = Vector3Add(position, query.Movement);
+            map.MovePlayer(newPosition, position, PlayerRadius, PlayerHeight);
+            position = newPosition;
+        }
+    }
+
+    return queries;
+}
+
+// cylinders at all heights around a wall, some landing on it or hitting it from below, and rays from near the wall toward it
+static std::vector<KernelInput> BuildKernelInputs(Map& map)
+{
+    std::vector<KernelInput> inputs(ColdKernelInputs);
+    for (KernelInput& input : inputs)
+    {
+        input.Wall = GetRandomValue(0, int(map.Walls.size()) - 1);
+        Obstacle& wall = map.Walls[input.Wall];
+
+        BoundingBox reach = wall.Bounds + Vector3{ PlayerRadius * 2, 0, PlayerRadius * 2 };
+        input.Center = Vector3{ RandomFloat(reach.min.x, reach.max.x), RandomFloat(reach.min.y - PlayerHeight - 0.5f, reach.max.y + 0.5f), RandomFloat(reach.min.z, reach.max.z) };
+        input.OldCenter = Vector3Add(input.Center, Vector3{ RandomFloat(-0.5f, 0.5f), RandomFloat(-1, 1), RandomFloat(-0.5f, 0.5f) });
+        input.WorldCenter = Vector3Transform(input.Center, wall.GetWorldMatrix());
+        input.WorldOldCenter = Vector3Transform(input.OldCenter, wall.GetWorldMatrix());
+
+        const OrientedBox& box = wall.GetWorldBox();
+        Vector3 target = Vector3Add(box.Center, Vector3{ RandomFloat(-10, 10), RandomFloat(-2, 2), RandomFloat(-10, 10) });
+        input.WorldRay.position = Vector3Add(box.Center, Vector3{ RandomFloat(-30, 30), RandomFloat(0, 3), RandomFloat(-30, 30) });
+        input.WorldRay.direction = Vector3Normalize(Vector3Subtract(target, input.WorldRay.position));
+
+        Vector3 halfSize = { RandomFloat(0.25f, 2), RandomFloat(0.25f, 2), RandomFloat(0.25f, 2) };
+        Quaternion turn = QuaternionFromEuler(RandomFloat(-PI, PI), RandomFloat(-PI, PI), RandomFloat(-PI, PI));
+        Matrix boxMatrix = MatrixMultiply(QuaternionToMatrix(turn), MatrixTranslate(input.WorldCenter.x, input.WorldCenter.y, input.WorldCenter.z));
+        input.Box = OrientedBoxFromBounds(BoundingBox{ Vector3Negate(halfSize), halfSize }, boxMatrix);
+    }
+
+    return inputs;
+}
+
+static void BuildObstacleStore(Map& map, ObstacleStore& store)
+{
+    std::vector<Matrix> inverseMatrices;
+    std::vector<Matrix> worldMatrices;
+    std::vector<BoundingBox> localBounds;
+    for (Obstacle& wall : map.Walls)
+    {
+        inverseMatrices.push_back(wall.GetInverseWorldMatrix());
+        worldMatrices.push_back(wall.GetWorldMatrix());
+        localBounds.push_back(wall.Bounds);
+    }
+
+    store.Build(inverseMatrices, worldMatrices, localBounds);
+}
+
+// a packet of the walls of 8 inputs in a row, with the wall of the given input in the lane it falls on
+// the cylinder of that input is next to its own wall and usually far from the others
+static void GatherInputPacket(const ObstacleStore& store, const std::vector<KernelInput>& inputs, const int* order, int input, ObstacleStore::Packet& packet)
+{
+    int first = input - input % ObstacleStore::PacketSize;
+
+    int walls[ObstacleStore::PacketSize];
+    for (int lane = 0; lane < ObstacleStore::PacketSize; lane++)
+        walls[lane] = inputs[order[(first + lane) % ColdKernelInputs]].Wall;
+
+    store.GatherPacket(walls, ObstacleStore::PacketSize, packet);
+}
+
+static Rectangle GetWallRectangle(const Obstacle& wall)
+{
+    return Rectangle{ wall.Bounds.min.x, wall.Bounds.min.z, wall.Bounds.max.x - wall.Bounds.min.x, wall.Bounds.max.z - wall.Bounds.min.z };
+}
+
+// the function is given a range of queries to run, each range is one sample
+template<class Function>
+static QueryTimes TimeQueries(int count, int queriesPerSample, Function queryRange)
+{
+    QueryTimes times;
+    times.Queries = count;
+    times.Samples.reserve(count / queriesPerSample + 1);
+
+    for (int first = 0; first < count; first += queriesPerSample)
+    {
+        int last = std::min(count, first + queriesPerSample);
+
+        auto start = std::chrono::steady_clock::now();
+        queryRange(first, last);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        times.Seconds += seconds;
+        times.Samples.push_back(float(seconds * 1e9 / (last - first)));
+    }
+
+    return times;
+}
+
+static float Percentile(std::vector<float> samples, float fraction)
+{
+    size_t index = std::min(samples.size() - 1, size_t(fraction * samples.size()));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+static void PrintQueryTimes(const char* name, const char* order, const QueryTimes& times)
+{
+    printf("%-28s %-9s %10.1f %12.0f %9.1f %9.1f\n", name, order, times.Seconds * 1e9 / times.Queries, times.Queries / times.Seconds,
+        Percentile(times.Samples, 0.5f), Percentile(times.Samples, 0.99f));
+}
+
+static bool Matches(float value, float reference)
+{
+    return fabsf(value - reference) <= ResultTolerance * std::max(1.0f, fabsf(reference));
+}
+
+static bool Matches(Vector3 value, Vector3 reference)
+{
+    return Matches(value.x, reference.x) && Matches(value.y, reference.y) && Matches(value.z, reference.z);
+}
+
+// a ray that grazes a wall or hits it right on an edge can come out either way from float error,
+// so it is only checked when growing and shrinking the wall a little gives the same answer
+static bool IsRayCheckable(const Obstacle& wall, Ray worldRay, bool& checkNormal)
+{
+    RayCollision grown = { 0 };
+    RayCollision shrunk = { 0 };
+    ReferenceCheckRaycast(wall, worldRay, grown, ResultTolerance);
+    ReferenceCheckRaycast(wall, worldRay, shrunk, -ResultTolerance);
+
+    if (grown.hit != shrunk.hit)
+        return false;
+
+    checkNormal = Matches(grown.normal, shrunk.normal);
+    return !grown.hit || Matches(grown.distance, shrunk.distance);
+}
+
+static int ReportMismatches(const char* name, int mismatches, int checked)
+{
+    if (mismatches > 0)
+        printf("%s: %d of %d did not match\n", name, mismatches, checked);
+
+    return mismatches;
+}
+
+static int RunMapBenchmark(Map& map, const CollisionBenchmarkOptions& options)
+{
+    std::vector<PathQuery> queries = BuildPaths(map, options);
+    int count = int(queries.size());
+
+    std::vector<int> pathOrder(count);
+    for (int i = 0; i < count; i++)
+        pathOrder[i] = i;
+
+    std::vector<int> shuffledOrder = ShuffledOrder(count);
+
+    std::vector<Vector3> positions(count);
+    std::vector<RayCollision> singleHits(count);
+    std::vector<RayCollision> batchHits(count);
+
+    std::vector<Ray> pathRays(count);
+    for (int i = 0; i < count; i++)
+        pathRays[i] = queries[i].GunRay;
+
+    std::vector<Ray> shuffledRays(count);
+    for (int i = 0; i < count; i++)
+        shuffledRays[i] = queries[shuffledOrder[i]].GunRay;
+
+    struct QueryOrder
+    {
+        const char* Name;
+        const std::vector<int>* Order;
+        const std::vector<Ray>* Rays;
+    };
+
+    const QueryOrder orders[] = { { "path", &pathOrder, &pathRays }, { "shuffled", &shuffledOrder, &shuffledRays } };
+
+    for (const QueryOrder& order : orders)
+    {
+        const std::vector<int>& indices = *order.Order;
+
+        QueryTimes collideTimes = TimeQueries(count, 1, [&](int first, int last)
+            {
+                for (int i = first; i < last; i++)
+                {
+                    const PathQuery& query = queries[indices[i]];
+                    positions[i] = Vector3Add(query.Position, query.Movement);
+                    map.CollidePlayer(positions[i], query.Position, PlayerRadius, PlayerHeight);
+                }
+            });
+
+        QueryTimes moveTimes = TimeQueries(count, 1, [&](int first, int last)
+            {
+                for (int i = first; i < last; i++)
+                {
+                    const PathQuery& query = queries[indices[i]];
+                    positions[i] = Vector3Add(query.Position, query.Movement);
+                    map.MovePlayer(positions[i], query.Position, PlayerRadius, PlayerHeight);
+                }
+            });
+
+        QueryTimes rayTimes = TimeQueries(count, 1, [&](int first, int last)
+            {
+                for (int i = first; i < last; i++)
+                    map.CollideRay(queries[indices[i]].GunRay, singleHits[i]);
+            });
+
+        QueryTimes sphereTimes = TimeQueries(count, 1, [&](int first, int last)
+            {
+                for (int i = first; i < last; i++)
+                    map.SphereCast(queries[indices[i]].CameraRay, CameraRadius, CameraPullback, singleHits[i]);
+            });
+
+        QueryTimes batchTimes = TimeQueries(count, RaysPerBatch, [&](int first, int last)
+            {
+                map.CollideRays(order.Rays->data() + first, batchHits.data() + first, last - first);
+            });
+
+        PrintQueryTimes("Map::CollidePlayer", order.Name, collideTimes);
+        PrintQueryTimes("Map::MovePlayer", order.Name, moveTimes);
+        PrintQueryTimes("Map::CollideRay", order.Name, rayTimes);
+        PrintQueryTimes("Map::CollideRays", order.Name, batchTimes);
+        PrintQueryTimes("Map::SphereCast", order.Name, sphereTimes);
+    }
+
+    // the shuffled order spreads the checked queries over every path
+    int checked = std::min(count, options.OracleQueries);
+    int collideMismatches = 0;
+    int moveMismatches = 0;
+    int rayMismatches = 0;
+    int sphereMismatches = 0;
+
+    for (int i = 0; i < checked; i++)
+    {
+        const PathQuery& query = queries[shuffledOrder[i]];
+
+        Vector3 position = Vector3Add(query.Position, query.Movement);
+        Vector3 referencePosition = position;
+        bool hit = map.CollidePlayer(position, query.Position, PlayerRadius, PlayerHeight);
+        bool referenceHit = ReferenceCollidePlayer(map, referencePosition, query.Position, PlayerRadius, PlayerHeight);
+        if (hit != referenceHit || !Matches(position, referencePosition))
+            collideMismatches++;
+
+        // moves can't be checked against the old code, which could go through walls, so check that they end up clear of every wall
+        if (PlayerMapDepth(map, query.Position, PlayerRadius, PlayerHeight) <= 0)
+        {
+            position = Vector3Add(query.Position, query.Movement);
+            map.MovePlayer(position, query.Position, PlayerRadius, PlayerHeight);
+            if (PlayerMapDepth(map, position, PlayerRadius, PlayerHeight) > OverlapTolerance)
+                moveMismatches++;
+        }
+
+        RayCollision collision = { 0 };
+        RayCollision referenceCollision = { 0 };
+        map.CollideRay(query.GunRay, collision);
+        ReferenceCollideRay(map, query.GunRay, referenceCollision);
+        if (collision.hit != referenceCollision.hit || (collision.hit && !Matches(collision.distance, referenceCollision.distance)))
+            rayMismatches++;
+
+        // a miss stops the sphere at the full distance, so the distances can be compared either way
+        // a sphere that only grazes a wall is skipped, the same as the rays
+        float grownDistance = TraceSphere(map, query.CameraRay, CameraRadius + ResultTolerance, CameraPullback);
+        float shrunkDistance = TraceSphere(map, query.CameraRay, CameraRadius - ResultTolerance, CameraPullback);
+        if (shrunkDistance - grownDistance < GrazingSphereTolerance)
+        {
+            map.SphereCast(query.CameraRay, CameraRadius, CameraPullback, collision);
+            if (!Matches(collision.distance, TraceSphere(map, query.CameraRay, CameraRadius, CameraPullback)))
+                sphereMismatches++;
+        }
+    }
+
+    // the last timed batch was shuffled, so compare it to single rays in the same order
+    int batchMismatches = 0;
+    for (int i = 0; i < count; i++)
+    {
+        RayCollision collision = { 0 };
+        map.CollideRay(shuffledRays[i], collision);
+        if (collision.hit != batchHits[i].hit || (collision.hit && !Matches(batchHits[i].distance, collision.distance)))
+            batchMismatches++;
+    }
+
+    int failures = ReportMismatches("Map::CollidePlayer", collideMismatches, checked);
+    failures += ReportMismatches("Map::MovePlayer ending inside a wall", moveMismatches, checked);
+    failures += ReportMismatches("Map::CollideRay", rayMismatches, checked);
+    failures += ReportMismatches("Map::CollideRays", batchMismatches, count);
+    failures += ReportMismatches("Map::SphereCast", sphereMismatches, checked);
+    return failures;
+}
+
+static int RunKernelBenchmark(Map& map, const CollisionBenchmarkOptions& options)
+{
+    std::vector<KernelInput> inputs = BuildKernelInputs(map);
+    std::vector<int> coldOrder = ShuffledOrder(ColdKernelInputs);
+
+    ObstacleStore store;
+    BuildObstacleStore(map, store);
+
+    int count = options.Queries * KernelQueryScale;
+    std::vector<KernelResult> results(count);
+
+    struct InputSet
+    {
+        const char* Name;
+        const int* Order;
+    };
+
+    // the hot set uses the first few inputs over and over, the cold set walks all of them in a random order
+    std::vector<int> hotOrder(ColdKernelInputs);
+    for (int i = 0; i < ColdKernelInputs; i++)
+        hotOrder[i] = i % HotKernelInputs;
+
+    const InputSet sets[] = { { "hot", hotOrder.data() }, { "cold", coldOrder.data() } };
+
+    for (const InputSet& set : sets)
+    {
+        QueryTimes cylinderTimes = TimeQueries(count, KernelQueriesPerSample, [&](int first, int last)
+            {
+                for (int i = first; i < last; i++)
+                {
+                    const KernelInput& input = inputs[set.Order[i % ColdKernelInputs]];
+                    KernelResult& result = results[i];
+                    result.Point = input.Center;
+
+                    Vector3 nearest = { 0 };
+                    result.Hit = IntersectBBoxCylinder(map.Walls[input.Wall].Bounds, result.Point, input.OldCenter, PlayerRadius, PlayerHeight, nearest, result.Normal);
+                }
+            });
+
+        QueryTimes nearestTimes = TimeQueries(count, KernelQueriesPerSample, [&](int first, int last)
+            {
+                for (int i = first; i < last; i++)
+                {
+                    const KernelInput& input = inputs[set.Order[i % ColdKernelInputs]];
+                    KernelResult& result = results[i];
+
+                    Vector2 nearest = { 0 };
+                    Vector2 normal = { 0 };
+                    PointNearestRectanglePoint(GetWallRectangle(map.Walls[input.Wall]), Vector2{ input.Center.x, input.Center.z }, nearest, normal);
+                    result.Point = Vector3{ nearest.x, 0, nearest.y };
+                    result.Normal = Vector3{ normal.x, 0, normal.y };
+                }
+            });
+
+        QueryTimes rayTimes = TimeQueries(count, KernelQueriesPerSample, [&](int first, int last)
+            {
+                for (int i = first; i < last; i++)
+                {
+                    const KernelInput& input = inputs[set.Order[i % ColdKernelInputs]];
+                    KernelResult& result = results[i];
+
+                    RayCollision collision = { 0 };
+                    result.Hit = map.Walls[input.Wall].CheckRaycast(input.WorldRay, collision);
+                    result.Point = collision.point;
+                }
+            });
+
+        QueryTimes boxTimes = TimeQueries(count, KernelQueriesPerSample, [&](int first, int last)
+            {
+                for (int i = first; i < last; i++)
+                {
+                    const KernelInput& input = inputs[set.Order[i % ColdKernelInputs]];
+                    results[i].Hit = CheckCollisionOrientedBoxes(map.Walls[input.Wall].GetWorldBox(), input.Box);
+                }
+            });
+
+        // the same cylinder tests 8 walls at a time, including gathering the walls into a packet
+        QueryTimes storeTimes = TimeQueries(count, KernelQueriesPerSample, [&](int first, int last)
+            {
+                ObstacleStore::Packet packet;
+                ObstacleStore::CylinderHits hits;
+                for (int i = first; i < last; i += ObstacleStore::PacketSize)
+                {
+                    const KernelInput& input = inputs[set.Order[i % ColdKernelInputs]];
+                    GatherInputPacket(store, inputs, set.Order, i % ColdKernelInputs, packet);
+                    store.CollideCylinder(packet, input.WorldCenter, input.WorldOldCenter, PlayerRadius, PlayerHeight, hits);
+                    results[i].Hit = hits.HitMask != 0;
+                    results[i].Point = hits.Push[0];
+                }
+            });
+
+        PrintQueryTimes("IntersectBBoxCylinder", set.Name, cylinderTimes);
+        PrintQueryTimes("ObstacleStore 8 walls", set.Name, storeTimes);
+        PrintQueryTimes("PointNearestRectanglePoint", set.Name, nearestTimes);
+        PrintQueryTimes("Obstacle::CheckRaycast", set.Name, rayTimes);
+        PrintQueryTimes("CheckCollisionOrientedBoxes", set.Name, boxTimes);
+    }
+
+    // every input is checked, the reference versions of these are cheap enough
+    int cylinderMismatches = 0;
+    int storeMismatches = 0;
+    int nearestMismatches = 0;
+    int rayMismatches = 0;
+    int boxMismatches = 0;
+
+    for (int i = 0; i < ColdKernelInputs; i++)
+    {
+        const KernelInput& input = inputs[coldOrder[i]];
+        Obstacle& wall = map.Walls[input.Wall];
+
+        Vector3 center = input.Center;
+        Vector3 referenceCenter = input.Center;
+        Vector3 point = { 0 };
+        Vector3 normal = { 0 };
+        Vector3 referencePoint = { 0 };
+        Vector3 referenceNormal = { 0 };
+        bool hit = IntersectBBoxCylinder(wall.Bounds, center, input.OldCenter, PlayerRadius, PlayerHeight, point, normal);
+        bool referenceHit = ReferenceIntersectBBoxCylinder(wall.Bounds, referenceCenter, input.OldCenter, PlayerRadius, PlayerHeight, referencePoint, referenceNormal);
+        if (hit != referenceHit || !Matches(center, referenceCenter) || (hit && !Matches(normal, referenceNormal)))
+            cylinderMismatches++;
+
+        // every lane of the packet against the test on that wall alone, the cylinder lands in a different lane each time
+        ObstacleStore::Packet packet;
+        ObstacleStore::CylinderHits hits;
+        GatherInputPacket(store, inputs, coldOrder.data(), i, packet);
+        store.CollideCylinder(packet, input.WorldCenter, input.WorldOldCenter, PlayerRadius, PlayerHeight, hits);
+
+        for (int lane = 0; lane < ObstacleStore::PacketSize; lane++)
+        {
+            Obstacle& laneWall = map.Walls[packet.Index[lane]];
+            Vector3 laneCenter = Vector3Transform(input.WorldCenter, laneWall.GetInverseWorldMatrix());
+            Vector3 laneOldCenter = Vector3Transform(input.WorldOldCenter, laneWall.GetInverseWorldMatrix());
+            Vector3 lanePoint = { 0 };
+            Vector3 laneNormal = { 0 };
+            bool laneHit = ReferenceIntersectBBoxCylinder(laneWall.Bounds, laneCenter, laneOldCenter, PlayerRadius, PlayerHeight, lanePoint, laneNormal);
+
+            // landing on top and coming up from below are handed back to the scalar test, so only the hit can be checked
+            bool storeHit = (hits.HitMask | hits.ScalarMask) & (1 << lane);
+            if (storeHit != laneHit)
+                storeMismatches++;
+            else if (hits.HitMask & (1 << lane))
+            {
+                Vector3 push = Vector3Subtract(Vector3Transform(laneCenter, laneWall.GetWorldMatrix()), input.WorldCenter);
+                Vector3 normal = Vector3Subtract(Vector3Transform(laneNormal, laneWall.GetWorldMatrix()), Vector3Transform(Vector3Zero(), laneWall.GetWorldMatrix()));
+                if (!Matches(hits.Push[lane], push) || !Matches(hits.Normal[lane], normal))
+                    storeMismatches++;
+            }
+        }
+
+        Vector2 nearest2d = { 0 };
+        Vector2 normal2d = { 0 };
+        Vector2 referenceNearest2d = { 0 };
+        Vector2 referenceNormal2d = { 0 };
+        PointNearestRectanglePoint(GetWallRectangle(wall), Vector2{ input.Center.x, input.Center.z }, nearest2d, normal2d);
+        ReferencePointNearestRectanglePoint(GetWallRectangle(wall), Vector2{ input.Center.x, input.Center.z }, referenceNearest2d, referenceNormal2d);
+        if (!Matches(Vector3{ nearest2d.x, normal2d.x, nearest2d.y }, Vector3{ referenceNearest2d.x, referenceNormal2d.x, referenceNearest2d.y }) || !Matches(normal2d.y, referenceNormal2d.y))
+            nearestMismatches++;
+
+        // boxes that only just touch or only just miss can come out either way from float error
+        float overlap = OrientedBoxOverlap(wall.GetWorldBox(), input.Box);
+        if (fabsf(overlap) > ResultTolerance && CheckCollisionOrientedBoxes(wall.GetWorldBox(), input.Box) != (overlap > 0))
+            boxMismatches++;
+
+        bool checkNormal = false;
+        if (!IsRayCheckable(wall, input.WorldRay, checkNormal))
+            continue;
+
+        RayCollision collision = { 0 };
+        RayCollision referenceCollision = { 0 };
+        wall.CheckRaycast(input.WorldRay, collision);
+        ReferenceCheckRaycast(wall, input.WorldRay, referenceCollision);
+        if (collision.hit != referenceCollision.hit)
+            rayMismatches++;
+        else if (collision.hit && (!Matches(collision.distance, referenceCollision.distance) || (checkNormal && !Matches(collision.normal, referenceCollision.normal))))
+            rayMismatches++;
+    }
+
+    int failures = ReportMismatches("IntersectBBoxCylinder", cylinderMismatches, ColdKernelInputs);
+    failures += ReportMismatches("ObstacleStore lanes", storeMismatches, ColdKernelInputs * ObstacleStore::PacketSize);
+    failures += ReportMismatches("PointNearestRectanglePoint", nearestMismatches, ColdKernelInputs);
+    failures += ReportMismatches("Obstacle::CheckRaycast", rayMismatches, ColdKernelInputs);
+    failures += ReportMismatches("CheckCollisionOrientedBoxes", boxMismatches, ColdKernelInputs);
+    return failures;
+}
+
+static bool Matches(const Matrix& value, const Matrix& reference)
+{
+    const float* values = &value.m0;
+    const float* references = &reference.m0;
+    for (int i = 0; i < 16; i++)
+    {
+        if (!Matches(values[i], references[i]))
+            return false;
+    }
+
+    return true;
+}
+
+// a node moving to a new place in the transform hierarchy
+struct TransformMove
+{
+    int Node = 0;
+    Vector3 Position = { 0 };
+    float Turn = 0;
+};
+
+// a node of the transform hierarchy, each one has a random parent from the nodes before it
+struct TransformNode
+{
+    int Parent = 0;
+    Vector3 Position = { 0 };
+    Vector3 Angles = { 0 };
+};
+
+static std::vector<TransformNode> BuildTransformNodes(int count)
+{
+    std::vector<TransformNode> nodes(count);
+    for (int i = 0; i < count; i++)
+    {
+        nodes[i].Parent = i > 0 ? GetRandomValue(0, i - 1) : 0;
+        nodes[i].Position = Vector3{ RandomFloat(-1, 1), RandomFloat(-1, 1), RandomFloat(-1, 1) };
+        nodes[i].Angles = Vector3{ RandomFloat(-180, 180), RandomFloat(-180, 180), RandomFloat(-180, 180) };
+    }
+
+    return nodes;
+}
+
+// the transforms are made in a random order, so they are spread over the heap the way a game's would be
+static std::vector<std::unique_ptr<ObjectTransform>> BuildTransformHierarchy(const std::vector<TransformNode>& nodes)
+{
+    int count = int(nodes.size());
+    std::vector<std::unique_ptr<ObjectTransform>> transforms(count);
+    for (int index : ShuffledOrder(count))
+        transforms[index] = std::make_unique<ObjectTransform>();
+
+    for (int i = 0; i < count; i++)
+    {
+        transforms[i]->SetPosition(nodes[i].Position);
+        transforms[i]->SetOrientation(nodes[i].Angles);
+
+        if (i > 0)
+            transforms[nodes[i].Parent]->AddChild(*transforms[i]);
+    }
+
+    return transforms;
+}
+
+// every node read each frame, the sum keeps the reads from being optimized away
+static float ReadWorldMatrices(std::vector<std::unique_ptr<ObjectTransform>>& nodes)
+{
+    float sum = 0;
+    for (auto& node : nodes)
+        sum += node->GetWorldMatrix().m12;
+
+    return sum;
+}
+
+static int RunTransformBenchmark(const CollisionBenchmarkOptions& options)
+{
+    std::vector<TransformNode> nodes = BuildTransformNodes(options.TransformNodes);
+    std::vector<std::unique_ptr<ObjectTransform>> pointerNodes = BuildTransformHierarchy(nodes);
+    std::vector<std::unique_ptr<ObjectTransform>> graphNodes = BuildTransformHierarchy(nodes);
+
+    // the second hierarchy moves into a graph from the root down
+    TransformGraph graph;
+    graphNodes[0]->MoveToGraph(graph);
+
+    std::vector<TransformMove> moves(options.TransformFrames * TransformMovesPerFrame);
+    for (TransformMove& move : moves)
+    {
+        move.Node = GetRandomValue(0, options.TransformNodes - 1);
+        move.Position = Vector3{ RandomFloat(-1, 1), RandomFloat(-1, 1), RandomFloat(-1, 1) };
+        move.Turn = RandomFloat(-10, 10);
+    }
+
+    float sum = 0;
+    auto runFrames = [&](std::vector<std::unique_ptr<ObjectTransform>>& nodes)
+    {
+        return TimeQueries(options.TransformFrames, 1, [&](int first, int last)
+            {
+                for (int frame = first; frame < last; frame++)
+                {
+                    for (int i = 0; i < TransformMovesPerFrame; i++)
+                    {
+                        const TransformMove& move = moves[frame * TransformMovesPerFrame + i];
+                        nodes[move.Node]->SetPosition(move.Position);
+                        nodes[move.Node]->RotateV(move.Turn);
+                    }
+
+                    sum += ReadWorldMatrices(nodes);
+                }
+            });
+    };
+
+    QueryTimes pointerTimes = runFrames(pointerNodes);
+    QueryTimes graphTimes = runFrames(graphNodes);
+
+    // the same frames on a graph used directly, with no transform objects to go through
+    TransformGraph directGraph;
+    for (int i = 0; i < options.TransformNodes; i++)
+    {
+        int node = directGraph.AddNode(i > 0 ? nodes[i].Parent : TransformGraph::NoParent);
+        Vector3 angles = Vector3Scale(nodes[i].Angles, DEG2RAD);
+        directGraph.SetPosition(node, nodes[i].Position);
+        directGraph.SetOrientation(node, QuaternionFromEuler(angles.x, angles.y, angles.z));
+    }
+
+    QueryTimes directTimes = TimeQueries(options.TransformFrames, 1, [&](int first, int last)
+        {
+            for (int frame = first; frame < last; frame++)
+            {
+                for (int i = 0; i < TransformMovesPerFrame; i++)
+                {
+                    const TransformMove& move = moves[frame * TransformMovesPerFrame + i];
+                    directGraph.SetPosition(move.Node, move.Position);
+                    directGraph.SetOrientation(move.Node, QuaternionMultiply(QuaternionFromEuler(0, -move.Turn * DEG2RAD, 0), directGraph.GetOrientation(move.Node)));
+                }
+
+                directGraph.UpdateWorldMatrices();
+                for (int node = 0; node < options.TransformNodes; node++)
+                    sum += directGraph.GetWorldMatrix(node).m12;
+            }
+        });
+
+    PrintQueryTimes("ObjectTransform pointers", "frame", pointerTimes);
+    PrintQueryTimes("ObjectTransform in graph", "frame", graphTimes);
+    PrintQueryTimes("TransformGraph", "frame", directTimes);
+
+    // all three had the same frames, so they should have ended up the same
+    int directMismatches = 0;
+    for (int i = 0; i < options.TransformNodes; i++)
+    {
+        if (!Matches(directGraph.GetWorldMatrix(i), pointerNodes[i]->GetWorldMatrix()))
+            directMismatches++;
+    }
+
+    // move some nodes under nodes made after them, so the graph has to sort itself again, then every node has to match
+    for (int i = 0; i < TransformMovesPerFrame; i++)
+    {
+        int node = GetRandomValue(1, options.TransformNodes - 1);
+        int parent = GetRandomValue(node, options.TransformNodes - 1);
+
+        bool below = false;
+        for (ObjectTransform* above = pointerNodes[parent].get(); above != nullptr; above = above->GetParent())
+            below |= above == pointerNodes[node].get();
+
+        if (below)
+            continue;
+
+        pointerNodes[parent]->AddChild(*pointerNodes[node]);
+        graphNodes[parent]->AddChild(*graphNodes[node]);
+    }
+
+    // plain transforms added under graph nodes after the move have to join the graph and follow their parents
+    int lateCount = TransformMovesPerFrame;
+    std::vector<std::unique_ptr<ObjectTransform>> pointerLate(lateCount);
+    std::vector<std::unique_ptr<ObjectTransform>> graphLate(lateCount);
+    for (int i = 0; i < lateCount; i++)
+    {
+        int parent = GetRandomValue(0, options.TransformNodes - 1);
+        Vector3 position = Vector3{ RandomFloat(-1, 1), RandomFloat(-1, 1), RandomFloat(-1, 1) };
+
+        pointerLate[i] = std::make_unique<ObjectTransform>();
+        graphLate[i] = std::make_unique<ObjectTransform>();
+        pointerLate[i]->SetPosition(position);
+        graphLate[i]->SetPosition(position);
+
+        // read before and after the parent moves, so a stale matrix would show
+        pointerNodes[parent]->AddChild(*pointerLate[i]);
+        graphNodes[parent]->AddChild(*graphLate[i]);
+        pointerLate[i]->GetWorldMatrix();
+        graphLate[i]->GetWorldMatrix();
+
+        pointerNodes[parent]->MovePosition(1, 0, 0);
+        graphNodes[parent]->MovePosition(1, 0, 0);
+    }
+
+    int mismatches = 0;
+    for (int i = 0; i < options.TransformNodes; i++)
+    {
+        if (!Matches(graphNodes[i]->GetWorldMatrix(), pointerNodes[i]->GetWorldMatrix()))
+            mismatches++;
+    }
+
+    for (int i = 0; i < lateCount; i++)
+    {
+        if (!Matches(graphLate[i]->GetWorldMatrix(), pointerLate[i]->GetWorldMatrix()))
+            mismatches++;
+    }
+
+    // walls in a graph keep their own cached matrices, which have to notice a move even after another wall's read updated the graph
+    TransformGraph wallGraph;
+    std::vector<Obstacle> walls;
+    for (int i = 0; i < TransformMovesPerFrame; i++)
+        walls.emplace_back(RandomFloat(-10, 10), RandomFloat(-10, 10), 1.0f, 2.0f, 3.0f, RandomFloat(-180, 180));
+
+    for (Obstacle& wall : walls)
+        wall.Transform.MoveToGraph(wallGraph);
+
+    for (Obstacle& wall : walls)
+        wall.GetWorldMatrix();
+
+    int wallMismatches = 0;
+    for (size_t i = 0; i < walls.size(); i++)
+    {
+        Obstacle& wall = walls[i];
+        Obstacle& other = walls[(i + 1) % walls.size()];
+
+        wall.Transform.MovePosition(1, 0, 0);
+        if (!wall.Transform.IsDirty() || other.Transform.IsDirty())
+            wallMismatches++;
+
+        other.Transform.GetWorldMatrix();
+        if (!Matches(wall.GetWorldMatrix(), wall.Transform.GetWorldMatrix()))
+            wallMismatches++;
+    }
+
+    if (sum == 0)
+        printf("transform hierarchy summed to zero\n");
+
+    int failures = ReportMismatches("TransformGraph", directMismatches, options.TransformNodes);
+    failures += ReportMismatches("ObjectTransform in graph", mismatches, options.TransformNodes + lateCount);
+    failures += ReportMismatches("Obstacle in graph", wallMismatches, int(walls.size()));
+    return failures;
+}
+
+int RunCollisionBenchmark(const CollisionBenchmarkOptions& options)
+{
+    SetRandomSeed(options.Seed);
+
+    Map map;
+    BuildBenchmarkMap(map, options);
+
+    printf("collision benchmark, %d walls, %d map queries on paths of %d steps, %d collision tests\n",
+        int(map.Walls.size()), options.Queries, options.PathLength, options.Queries * KernelQueryScale);
+    printf("%-28s %-9s %10s %12s %9s %9s\n", "query", "inputs", "ns/query", "queries/s", "p50 ns", "p99 ns");
+
+    int failures = RunMapBenchmark(map, options);
+    failures += RunKernelBenchmark(map, options);
+    failures += RunTransformBenchmark(options);
+
+    if (failures == 0)
+        printf("every check passed\n");
+
+    return failures;
+}
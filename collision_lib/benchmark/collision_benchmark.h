@@ -0,0 +1,68 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+// what the collision benchmark builds and how many queries it times
+struct CollisionBenchmarkOptions
+{
+    // random walls added around the demo map
+    int Walls = 2000;
+
+    // walls are scattered over a square this many units across, centered on the origin
+    float FieldSize = 400;
+
+    // how many player moves and rays are timed for each query type, the small collision tests get 10 times as many
+    int Queries = 100000;
+
+    // the players walk paths this many steps long, so queries next to each other in a path touch the same walls
+    int PathLength = 200;
+
+    // how many queries of each type are checked against the reference code, which tests every wall
+    int OracleQueries = 2000;
+
+    // the transform hierarchy timed with parent pointers and as a flat graph, and how many frames of moves it gets
+    int TransformNodes = 50000;
+    int TransformFrames = 200;
+
+    unsigned int Seed = 1234;
+};
+
+// Time the collision queries without a window, on the demo map with a field of random walls.
+// The map queries (CollidePlayer, MovePlayer, CollideRay and CollideRays) follow random player paths, and are timed
+// both in path order and shuffled, so the grid cells and walls each query needs are rarely already in the cache.
+// The small collision tests (IntersectBBoxCylinder, PointNearestRectanglePoint, Obstacle::CheckRaycast and
+// CheckCollisionOrientedBoxes) are timed on a few inputs that stay in the cache and on a million inputs that don't.
+// A random transform hierarchy is timed for a frame of moves and world matrix reads, once with parent pointers and once
+// kept in a TransformGraph.
+// Each line reports the time per query, queries per second and the p50 and p99 latency.
+// Every query type is checked against the reference code in collision_reference.h, players must not end a move inside
+// a wall, oriented box overlaps must match projecting every corner, batched rays must match single rays and graph
+// world matrices must match the pointer hierarchy.
+// Returns the number of failed checks, 0 when every check passed.
+int RunCollisionBenchmark(const CollisionBenchmarkOptions& options);
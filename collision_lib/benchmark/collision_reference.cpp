@@ -26,14 +26,71 @@
 *
 **********************************************************************************************/
 
-#include <limits>
+#include "collision_reference.h"
+
+#include "map.h"
 
-#include "collisions.h"
-#include "raylib.h"
 #include "raymath.h"
 
-// check if a cylinder hits a bounding box
-bool IntersectBBoxCylinder(BoundingBox bounds, Vector3& center, Vector3 initalPosition, float radius, float height, Vector3& intersectionPoint, Vector3& hitNormal)
+#include <limits>
+
+void ReferencePointNearestRectanglePoint(Rectangle rect, Vector2 point, Vector2& nearest, Vector2& normal)
+{
+    // get the closest point on the vertical sides
+    float hValue = rect.x;
+    float hNormal = -1;
+    if (point.x > rect.x + rect.width)
+    {
+        hValue = rect.x + rect.width;
+        hNormal = 1;
+    }
+
+    Vector2 vecToPoint = Vector2Subtract(Vector2{ hValue, rect.y }, point);
+    // get the dot product between the ray and the vector to the point
+    float dotForPoint = Vector2DotProduct(Vector2{ 0, -1 }, vecToPoint);
+    Vector2 nearestPoint = { hValue, 0 };
+
+    if (dotForPoint < 0)
+        nearestPoint.y = rect.y;
+    else if (dotForPoint >= rect.height)
+        nearestPoint.y = rect.y + rect.height;
+    else
+        nearestPoint.y = rect.y + dotForPoint;
+
+    // get the closest point on the horizontal sides
+    float vValue = rect.y;
+    float vNormal = -1;
+    if (point.y > rect.y + rect.height)
+    {
+        vValue = rect.y + rect.height;
+        vNormal = 1;
+    }
+
+    vecToPoint = Vector2Subtract(Vector2{ rect.x, vValue }, point);
+    // get the dot product between the ray and the vector to the point
+    dotForPoint = Vector2DotProduct(Vector2{ -1, 0 }, vecToPoint);
+    nearest = Vector2{ 0,vValue };
+
+    if (dotForPoint < 0)
+        nearest.x = rect.x;
+    else if (dotForPoint >= rect.width)
+        nearest.x = rect.x + rect.width;
+    else
+        nearest.x = rect.x + dotForPoint;
+
+    if (Vector2LengthSqr(Vector2Subtract(point, nearestPoint)) <= Vector2LengthSqr(Vector2Subtract(point, nearest)))
+    {
+        nearest = nearestPoint;
+        normal.x = hNormal;
+        normal.y = 0;
+    }
+    else
+    {
+        normal.y = vNormal;
+        normal.x = 0;
+    }
+}
+bool ReferenceIntersectBBoxCylinder(BoundingBox bounds, Vector3& center, Vector3 initalPosition, float radius, float height, Vector3& intersectionPoint, Vector3& hitNormal)
 {
     Rectangle rect = { bounds.min.x, bounds.min.z, bounds.max.x - bounds.min.x, bounds.max.z - bounds.min.z };
     Vector2 center2d = { center.x, center.z };
@@ -80,7 +137,7 @@ bool IntersectBBoxCylinder(BoundingBox bounds, Vector3& center, Vector3 initalPo
     Vector2 hitPoint = { std::numeric_limits<float>::min(), std::numeric_limits<float>::min() };
     Vector2 hitNormal2d = { 0 };
 
-    PointNearestRectanglePoint(rect, newPosOrigin, hitPoint, hitNormal2d);
+    ReferencePointNearestRectanglePoint(rect, newPosOrigin, hitPoint, hitNormal2d);
 
     Vector2 vectorToHit = Vector2Subtract(hitPoint, newPosOrigin);
 
@@ -111,66 +168,62 @@ bool IntersectBBoxCylinder(BoundingBox bounds, Vector3& center, Vector3 initalPo
     return true;
 }
 
-/// <summary>
-/// Returns the point on a rectangle that is nearest to a provided point
-/// </summary>
-/// <param name="rect">The rectangle to test against</param>
-/// <param name="point">The point you want to start from</param>
-/// <param name="nearest">A pointer that will be filed out with the point on the rectangle that is nearest to your passed in point</param>
-/// <param name="normal">A pointer that will be filed out with the the normal of the edge the nearest point is on</param>
-void PointNearestRectanglePoint(Rectangle rect, Vector2 point, Vector2& nearest, Vector2& normal)
+bool ReferenceCheckRaycast(const Obstacle& obstacle, Ray worldRay, RayCollision& collision, float radius)
 {
-    // get the closest point on the vertical sides
-    float hValue = rect.x;
-    float hNormal = -1;
-    if (point.x > rect.x + rect.width)
-    {
-        hValue = rect.x + rect.width;
-        hNormal = 1;
-    }
+    // walls have no parent, so the local matrix is the world matrix
+    Matrix worldMatrix = obstacle.Transform.GetLocalMatrix();
+    Matrix inverseWorldMatrix = MatrixInvert(worldMatrix);
 
-    Vector2 vecToPoint = Vector2Subtract(Vector2{ hValue, rect.y }, point);
-    // get the dot product between the ray and the vector to the point
-    float dotForPoint = Vector2DotProduct(Vector2{ 0, -1 }, vecToPoint);
-    Vector2 nearestPoint = { hValue, 0 };
+    Ray localRay = { 0 };
+    localRay.position = Vector3Transform(worldRay.position, inverseWorldMatrix);
+    localRay.direction = Vector3Subtract(Vector3Transform(worldRay.direction, inverseWorldMatrix), Vector3Transform(Vector3Zero(), inverseWorldMatrix));
 
-    if (dotForPoint < 0)
-        nearestPoint.y = rect.y;
-    else if (dotForPoint >= rect.height)
-        nearestPoint.y = rect.y + rect.height;
-    else
-        nearestPoint.y = rect.y + dotForPoint;
+    collision = GetRayCollisionBox(localRay, obstacle.Bounds + radius);
 
-    // get the closest point on the horizontal sides
-    float vValue = rect.y;
-    float vNormal = -1;
-    if (point.y > rect.y + rect.height)
+    if (collision.hit)
     {
-        vValue = rect.y + rect.height;
-        vNormal = 1;
+        collision.point = Vector3Transform(collision.point, worldMatrix);
+        collision.distance = Vector3Distance(worldRay.position, collision.point);
+        collision.normal = Vector3Subtract(Vector3Transform(collision.normal, worldMatrix), Vector3Transform(Vector3Zero(), worldMatrix));
     }
 
-    vecToPoint = Vector2Subtract(Vector2{ rect.x, vValue }, point);
-    // get the dot product between the ray and the vector to the point
-    dotForPoint = Vector2DotProduct(Vector2{ -1, 0 }, vecToPoint);
-    nearest = Vector2{ 0,vValue };
-
-    if (dotForPoint < 0)
-        nearest.x = rect.x;
-    else if (dotForPoint >= rect.width)
-        nearest.x = rect.x + rect.width;
-    else
-        nearest.x = rect.x + dotForPoint;
+    return collision.hit;
+}
 
-    if (Vector2LengthSqr(Vector2Subtract(point, nearestPoint)) <= Vector2LengthSqr(Vector2Subtract(point, nearest)))
+bool ReferenceCollidePlayer(const Map& map, Vector3& newPosition, Vector3 oldPosition, float radius, float height)
+{
+    bool hitSomething = false;
+    for (const Obstacle& wall : map.Walls)
     {
-        nearest = nearestPoint;
-        normal.x = hNormal;
-        normal.y = 0;
+        Matrix worldMatrix = wall.Transform.GetLocalMatrix();
+        Matrix inverseWorldMatrix = MatrixInvert(worldMatrix);
+
+        Vector3 localPos = Vector3Transform(newPosition, inverseWorldMatrix);
+        Vector3 localOldPos = Vector3Transform(oldPosition, inverseWorldMatrix);
+
+        Vector3 nearestPoint = { 0 };
+        Vector3 hitNormal = { 0 };
+        if (!ReferenceIntersectBBoxCylinder(wall.Bounds, localPos, localOldPos, radius, height, nearestPoint, hitNormal))
+            continue;
+
+        newPosition = Vector3Transform(localPos, worldMatrix);
+        hitSomething = true;
     }
-    else
+
+    return hitSomething;
+}
+
+bool ReferenceCollideRay(const Map& map, Ray worldRay, RayCollision& collision)
+{
+    collision.hit = false;
+    collision.distance = std::numeric_limits<float>::max();
+
+    for (const Obstacle& wall : map.Walls)
     {
-        normal.y = vNormal;
-        normal.x = 0;
+        RayCollision wallCollision = { 0 };
+        if (ReferenceCheckRaycast(wall, worldRay, wallCollision) && wallCollision.distance < collision.distance)
+            collision = wallCollision;
     }
-}
\ No newline at end of file
+
+    return collision.hit;
+}
@@ -0,0 +1,47 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "raylib.h"
+
+class Map;
+class Obstacle;
+
+// Copies of the collision queries as they were before any optimization work, the benchmark checks the real ones against them.
+// These are slow on purpose, every wall is tested and the wall matrices are rebuilt for every test, so leave them alone
+// when optimizing the real functions.
+
+void ReferencePointNearestRectanglePoint(Rectangle rect, Vector2 point, Vector2& nearest, Vector2& normal);
+bool ReferenceIntersectBBoxCylinder(BoundingBox bounds, Vector3& center, Vector3 initalPosition, float radius, float height, Vector3& intersectionPoint, Vector3& hitNormal);
+
+bool ReferenceCheckRaycast(const Obstacle& obstacle, Ray worldRay, RayCollision& collision, float radius = 0);
+
+// only the walls are tested, not the level mesh or the floor
+bool ReferenceCollidePlayer(const Map& map, Vector3& newPosition, Vector3 oldPosition, float radius, float height);
+bool ReferenceCollideRay(const Map& map, Ray worldRay, RayCollision& collision);
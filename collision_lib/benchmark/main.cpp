@@ -26,9 +26,10 @@
 *
 **********************************************************************************************/
 
-#pragma once
+#include "collision_benchmark.h"
 
-#include "raylib.h"
-
-void PointNearestRectanglePoint(Rectangle rect, Vector2 point, Vector2& nearest, Vector2& normal);
-bool IntersectBBoxCylinder(BoundingBox bounds, Vector3& center, Vector3 initalPosition, float radius, float height, Vector3& intersectionPoint, Vector3& hitNormal);
\ No newline at end of file
+// times the collision queries without opening a window, and fails if any of them stopped matching the reference code
+int main()
+{
+    return RunCollisionBenchmark(CollisionBenchmarkOptions()) == 0 ? 0 : 1;
+}
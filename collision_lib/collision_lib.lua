@@ -0,0 +1,61 @@
+-- shared collision and map code for the fps and tps collision examples
+collision_lib_dir = _SCRIPT_DIR
+
+function defineCollisionLibProject()
+    project "collision_lib"
+        kind "StaticLib"
+        location "_build"
+        language "C++"
+        targetdir "_bin/%{cfg.buildcfg}"
+
+        -- only the top folder, the tests and benchmark are their own programs
+        vpaths
+        {
+            ["Header Files/*"] = { collision_lib_dir .. "/include/**.h"},
+            ["Source Files/*"] = { collision_lib_dir .. "/*.cpp"},
+        }
+        files {collision_lib_dir .. "/include/**.h", collision_lib_dir .. "/*.cpp"}
+
+        includedirs { collision_lib_dir .. "/include" }
+        include_raylib()
+
+        filter "action:vs*"
+            characterset ("MBCS")
+
+        filter{}
+end
+
+-- a console program in a folder of the library, linked to the library and raylib
+local function defineCollisionProgram(name, folder)
+    project (name)
+        kind "ConsoleApp"
+        location "_build"
+        language "C++"
+        targetdir "_bin/%{cfg.buildcfg}"
+
+        vpaths
+        {
+            ["Header Files/*"] = { collision_lib_dir .. "/" .. folder .. "/**.h"},
+            ["Source Files/*"] = { collision_lib_dir .. "/" .. folder .. "/**.cpp"},
+        }
+        files {collision_lib_dir .. "/" .. folder .. "/**.h", collision_lib_dir .. "/" .. folder .. "/**.cpp"}
+
+        includedirs { collision_lib_dir .. "/" .. folder, collision_lib_dir .. "/include" }
+        links {"collision_lib"}
+        link_raylib()
+
+        -- the library needs raylib, so let the linker search both in any order
+        linkgroups "On"
+
+        filter "action:vs*"
+            debugdir "$(SolutionDir)"
+
+        filter{}
+end
+
+-- collision_tests checks the collision queries against known answers and exits with 1 when any check fails
+-- collision_benchmark times the queries and checks them against the reference code from before any optimization
+function defineCollisionTestProjects()
+    defineCollisionProgram("collision_tests", "tests")
+    defineCollisionProgram("collision_benchmark", "benchmark")
+end
@@ -0,0 +1,463 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include "collision_mesh.h"
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// deep enough for any tree built from median splits
+static constexpr int MaxTraversalDepth = 64;
+
+static float GetAxis(const Vector3& value, int axis)
+{
+    if (axis == 0)
+        return value.x;
+    if (axis == 1)
+        return value.y;
+    return value.z;
+}
+
+static bool RayHitsBounds(const BoundingBox& bounds, Vector3 origin, Vector3 inverseDirection, float maxDistance)
+{
+    float enter = 0;
+    float exit = maxDistance;
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        float near = (GetAxis(bounds.min, axis) - GetAxis(origin, axis)) * GetAxis(inverseDirection, axis);
+        float far = (GetAxis(bounds.max, axis) - GetAxis(origin, axis)) * GetAxis(inverseDirection, axis);
+        if (near > far)
+            std::swap(near, far);
+
+        enter = std::max(enter, near);
+        exit = std::min(exit, far);
+    }
+
+    return enter <= exit;
+}
+
+// Moller-Trumbore, hits from both sides of the triangle count
+static bool RayHitsTriangle(Vector3 origin, Vector3 direction, Vector3 a, Vector3 b, Vector3 c, float maxDistance, float& distance)
+{
+    Vector3 edge1 = Vector3Subtract(b, a);
+    Vector3 edge2 = Vector3Subtract(c, a);
+
+    Vector3 p = Vector3CrossProduct(direction, edge2);
+    float determinant = Vector3DotProduct(edge1, p);
+    if (fabsf(determinant) < EPSILON * EPSILON)
+        return false;
+
+    float inverseDeterminant = 1.0f / determinant;
+    Vector3 s = Vector3Subtract(origin, a);
+
+    float u = Vector3DotProduct(s, p) * inverseDeterminant;
+    if (u < 0 || u > 1)
+        return false;
+
+    Vector3 q = Vector3CrossProduct(s, edge1);
+    float v = Vector3DotProduct(direction, q) * inverseDeterminant;
+    if (v < 0 || u + v > 1)
+        return false;
+
+    distance = Vector3DotProduct(edge2, q) * inverseDeterminant;
+    return distance > EPSILON && distance < maxDistance;
+}
+
+// keep the part of a polygon that is strictly on one side of a height, side is 1 for above and -1 for below
+static int ClipPolygonHeight(const Vector3* input, int count, Vector3* output, float height, float side)
+{
+    int outputCount = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const Vector3& a = input[i];
+        const Vector3& b = input[(i + 1) % count];
+
+        float distanceA = (a.y - height) * side;
+        float distanceB = (b.y - height) * side;
+
+        if (distanceA > 0)
+            output[outputCount++] = a;
+
+        if ((distanceA > 0) != (distanceB > 0))
+            output[outputCount++] = Vector3Lerp(a, b, distanceA / (distanceA - distanceB));
+    }
+
+    return outputCount;
+}
+
+// find how far to move a standing cylinder sideways so it no longer overlaps a triangle
+// the triangle is cut down to the height of the cylinder, then it's a circle against a convex outline on the XZ plane
+static bool GetCylinderTrianglePush(Vector3 a, Vector3 b, Vector3 c, Vector3 position, float radius, float height, Vector2& push)
+{
+    // a triangle clipped by two planes has at most 5 corners
+    Vector3 triangle[3] = { a, b, c };
+    Vector3 clipped[8];
+    Vector3 outline[8];
+
+    int count = ClipPolygonHeight(triangle, 3, clipped, position.y, 1);
+    count = ClipPolygonHeight(clipped, count, outline, position.y + height, -1);
+    if (count < 3)
+        return false;
+
+    Vector2 center = { position.x, position.z };
+
+    float area = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const Vector3& start = outline[i];
+        const Vector3& end = outline[(i + 1) % count];
+        area += start.x * end.z - end.x * start.z;
+    }
+
+    // walls seen from above are only a sliver, so they never count as having the center inside them
+    bool inside = fabsf(area) > EPSILON;
+
+    float closestDistanceSquared = std::numeric_limits<float>::max();
+    Vector2 closestPoint = { 0 };
+    Vector2 closestEdge = { 0 };
+
+    for (int i = 0; i < count; i++)
+    {
+        Vector2 start = { outline[i].x, outline[i].z };
+        Vector2 end = { outline[(i + 1) % count].x, outline[(i + 1) % count].z };
+        Vector2 edge = Vector2Subtract(end, start);
+        Vector2 toCenter = Vector2Subtract(center, start);
+
+        if (inside && (edge.x * toCenter.y - edge.y * toCenter.x) * area < 0)
+            inside = false;
+
+        float lengthSquared = Vector2LengthSqr(edge);
+        float param = lengthSquared > 0 ? Clamp(Vector2DotProduct(toCenter, edge) / lengthSquared, 0, 1) : 0;
+        Vector2 point = Vector2Add(start, Vector2Scale(edge, param));
+
+        float distanceSquared = Vector2DistanceSqr(center, point);
+        if (distanceSquared < closestDistanceSquared)
+        {
+            closestDistanceSquared = distanceSquared;
+            closestPoint = point;
+            closestEdge = edge;
+        }
+    }
+
+    if (!inside && closestDistanceSquared >= radius * radius)
+        return false;
+
+    float distance = sqrtf(closestDistanceSquared);
+
+    // the outward side of an edge depends on which way the outline winds
+    Vector2 edgeNormal = Vector2Normalize(Vector2{ closestEdge.y, -closestEdge.x });
+    if (area < 0)
+        edgeNormal = Vector2Negate(edgeNormal);
+
+    if (inside)
+    {
+        // the center is over the triangle, so leave through the nearest edge
+        push = Vector2Scale(edgeNormal, distance + radius);
+        return true;
+    }
+
+    if (distance > 0)
+        push = Vector2Scale(Vector2Subtract(center, closestPoint), (radius - distance) / distance);
+    else
+        push = Vector2Scale(edgeNormal, radius);
+
+    return true;
+}
+
+void CollisionMesh::Clear()
+{
+    Triangles.clear();
+    Nodes.clear();
+}
+
+void CollisionMesh::AddMesh(const Mesh& mesh, Matrix transform)
+{
+    if (mesh.vertices == nullptr)
+        return;
+
+    auto getVertex = [&](int index)
+        {
+            return Vector3Transform(Vector3{ mesh.vertices[index * 3], mesh.vertices[index * 3 + 1], mesh.vertices[index * 3 + 2] }, transform);
+        };
+
+    for (int i = 0; i < mesh.triangleCount; i++)
+    {
+        int a = i * 3;
+        int b = i * 3 + 1;
+        int c = i * 3 + 2;
+        if (mesh.indices != nullptr)
+        {
+            a = mesh.indices[a];
+            b = mesh.indices[b];
+            c = mesh.indices[c];
+        }
+
+        Triangles.push_back(Triangle{ getVertex(a), getVertex(b), getVertex(c) });
+    }
+
+    // the tree no longer covers every triangle
+    Nodes.clear();
+}
+
+void CollisionMesh::AddModel(const Model& model)
+{
+    for (int i = 0; i < model.meshCount; i++)
+        AddMesh(model.meshes[i], model.transform);
+}
+
+void CollisionMesh::Build()
+{
+    Nodes.clear();
+    if (Triangles.empty())
+        return;
+
+    std::vector<Vector3> centers;
+    centers.reserve(Triangles.size());
+    for (const Triangle& triangle : Triangles)
+        centers.push_back(Vector3Scale(Vector3Add(Vector3Add(triangle.A, triangle.B), triangle.C), 1.0f / 3.0f));
+
+    // a binary tree with one or more triangles per leaf never has more than 2n - 1 nodes
+    Nodes.reserve(Triangles.size() * 2);
+    Nodes.emplace_back();
+    BuildNode(0, 0, int(Triangles.size()), centers);
+}
+
+void CollisionMesh::BuildNode(int nodeIndex, int first, int count, std::vector<Vector3>& centers)
+{
+    BoundingBox bounds = { Triangles[first].A, Triangles[first].A };
+    BoundingBox centerBounds = { centers[first], centers[first] };
+    for (int i = first; i < first + count; i++)
+    {
+        const Triangle& triangle = Triangles[i];
+        bounds.min = Vector3Min(bounds.min, Vector3Min(triangle.A, Vector3Min(triangle.B, triangle.C)));
+        bounds.max = Vector3Max(bounds.max, Vector3Max(triangle.A, Vector3Max(triangle.B, triangle.C)));
+
+        centerBounds.min = Vector3Min(centerBounds.min, centers[i]);
+        centerBounds.max = Vector3Max(centerBounds.max, centers[i]);
+    }
+
+    Nodes[nodeIndex].Bounds = bounds;
+
+    // split on the longest side of the triangle centers, unless they are all in the same place
+    Vector3 extent = Vector3Subtract(centerBounds.max, centerBounds.min);
+    int axis = 0;
+    if (extent.y > GetAxis(extent, axis))
+        axis = 1;
+    if (extent.z > GetAxis(extent, axis))
+        axis = 2;
+
+    if (count <= MaxLeafTriangles || GetAxis(extent, axis) <= 0)
+    {
+        Nodes[nodeIndex].First = first;
+        Nodes[nodeIndex].Count = count;
+        return;
+    }
+
+    // put the half of the triangles with the lower centers first, keeping the centers in the same order
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++)
+        order[i] = first + i;
+
+    int half = count / 2;
+    std::nth_element(order.begin(), order.begin() + half, order.end(), [&](int left, int right)
+        {
+            return GetAxis(centers[left], axis) < GetAxis(centers[right], axis);
+        });
+
+    std::vector<Triangle> sortedTriangles(count);
+    std::vector<Vector3> sortedCenters(count);
+    for (int i = 0; i < count; i++)
+    {
+        sortedTriangles[i] = Triangles[order[i]];
+        sortedCenters[i] = centers[order[i]];
+    }
+    std::copy(sortedTriangles.begin(), sortedTriangles.end(), Triangles.begin() + first);
+    std::copy(sortedCenters.begin(), sortedCenters.end(), centers.begin() + first);
+
+    int children = int(Nodes.size());
+    Nodes.emplace_back();
+    Nodes.emplace_back();
+
+    Nodes[nodeIndex].First = children;
+    Nodes[nodeIndex].Count = 0;
+
+    BuildNode(children, first, half, centers);
+    BuildNode(children + 1, first + half, count - half, centers);
+}
+
+bool CollisionMesh::CollideRay(Ray ray, RayCollision& collision, float maxDistance) const
+{
+    collision.hit = false;
+
+    float length = Vector3Length(ray.direction);
+    if (Nodes.empty() || length <= 0)
+        return false;
+
+    // work in world distances so the result can be compared with other hits
+    Vector3 direction = Vector3Scale(ray.direction, 1.0f / length);
+    Vector3 inverseDirection = { 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+
+    float closest = maxDistance;
+    int hitTriangle = -1;
+
+    int stack[MaxTraversalDepth];
+    int stackSize = 0;
+    if (RayHitsBounds(Nodes[0].Bounds, ray.position, inverseDirection, closest))
+        stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const Node& node = Nodes[stack[--stackSize]];
+
+        if (node.Count > 0)
+        {
+            for (int i = node.First; i < node.First + node.Count; i++)
+            {
+                float distance = 0;
+                const Triangle& triangle = Triangles[i];
+                if (RayHitsTriangle(ray.position, direction, triangle.A, triangle.B, triangle.C, closest, distance))
+                {
+                    closest = distance;
+                    hitTriangle = i;
+                }
+            }
+            continue;
+        }
+
+        // a closer hit can shrink the ray before a child comes off the stack, so boxes are tested again there
+        for (int child = node.First; child < node.First + 2; child++)
+        {
+            if (RayHitsBounds(Nodes[child].Bounds, ray.position, inverseDirection, closest))
+                stack[stackSize++] = child;
+        }
+    }
+
+    if (hitTriangle < 0)
+        return false;
+
+    const Triangle& triangle = Triangles[hitTriangle];
+    Vector3 normal = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(triangle.B, triangle.A), Vector3Subtract(triangle.C, triangle.A)));
+    if (Vector3DotProduct(normal, direction) > 0)
+        normal = Vector3Negate(normal);
+
+    collision.hit = true;
+    collision.distance = closest;
+    collision.point = Vector3Add(ray.position, Vector3Scale(direction, closest));
+    collision.normal = normal;
+    return true;
+}
+
+bool CollisionMesh::CollideCylinder(Vector3& position, float radius, float height)
+{
+    if (Nodes.empty())
+        return false;
+
+    bool hitSomething = false;
+
+    // in a corner one push can move the cylinder into the next triangle, so go over them again until nothing moves
+    for (int pass = 0; pass < MaxPushPasses; pass++)
+    {
+        BoundingBox bounds = { Vector3{ position.x - radius, position.y, position.z - radius }, Vector3{ position.x + radius, position.y + height, position.z + radius } };
+        QueryBounds(bounds, Candidates);
+
+        bool pushed = false;
+        for (int index : Candidates)
+        {
+            const Triangle& triangle = Triangles[index];
+
+            Vector2 push = { 0 };
+            if (!GetCylinderTrianglePush(triangle.A, triangle.B, triangle.C, position, radius, height, push))
+                continue;
+
+            position.x += push.x;
+            position.z += push.y;
+            pushed = true;
+        }
+
+        if (!pushed)
+            break;
+
+        hitSomething = true;
+    }
+
+    return hitSomething;
+}
+
+bool CollisionMesh::MoveCylinder(Vector3& newPosition, Vector3 oldPosition, float radius, float height)
+{
+    if (Nodes.empty())
+        return false;
+
+    // steps of half the radius can't carry the center across a triangle without it being pushed back first
+    Vector3 movement = Vector3Subtract(newPosition, oldPosition);
+    int steps = std::max(1, int(ceilf(Vector3Length(movement) / (radius * 0.5f))));
+    Vector3 step = Vector3Scale(movement, 1.0f / steps);
+
+    Vector3 position = oldPosition;
+    bool hitSomething = false;
+    for (int i = 0; i < steps; i++)
+    {
+        position = Vector3Add(position, step);
+        if (CollideCylinder(position, radius, height))
+            hitSomething = true;
+    }
+
+    newPosition = position;
+    return hitSomething;
+}
+
+void CollisionMesh::QueryBounds(const BoundingBox& box, std::vector<int>& results) const
+{
+    results.clear();
+    if (Nodes.empty())
+        return;
+
+    int stack[MaxTraversalDepth];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const Node& node = Nodes[stack[--stackSize]];
+        if (!CheckCollisionBoxes(node.Bounds, box))
+            continue;
+
+        if (node.Count > 0)
+        {
+            for (int i = node.First; i < node.First + node.Count; i++)
+                results.push_back(i);
+            continue;
+        }
+
+        stack[stackSize++] = node.First;
+        stack[stackSize++] = node.First + 1;
+    }
+}
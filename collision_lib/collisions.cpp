@@ -0,0 +1,591 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "collisions.h"
+#include "raylib.h"
+#include "raymath.h"
+
+// build an oriented box from a local bounding box and the matrix that takes it into another space
+OrientedBox OrientedBoxFromBounds(BoundingBox bounds, const Matrix& transform)
+{
+    OrientedBox box;
+    box.Center = Vector3Transform(Vector3Lerp(bounds.min, bounds.max, 0.5f), transform);
+
+    Vector3 columns[3] = { { transform.m0, transform.m1, transform.m2 }, { transform.m4, transform.m5, transform.m6 }, { transform.m8, transform.m9, transform.m10 } };
+    float halfSize[3] = { (bounds.max.x - bounds.min.x) * 0.5f, (bounds.max.y - bounds.min.y) * 0.5f, (bounds.max.z - bounds.min.z) * 0.5f };
+
+    // any scale in the matrix goes into the extents so the axes stay unit length
+    for (int i = 0; i < 3; i++)
+    {
+        float scale = Vector3Length(columns[i]);
+        box.Axes[i] = Vector3Scale(columns[i], 1.0f / scale);
+        halfSize[i] *= scale;
+    }
+
+    box.HalfExtents = Vector3{ halfSize[0], halfSize[1], halfSize[2] };
+    return box;
+}
+
+// get the axis aligned box that contains an oriented box
+BoundingBox GetOrientedBoxBounds(const OrientedBox& box)
+{
+    Vector3 extents = Vector3Add(Vector3Add(
+        Vector3Scale(Vector3{ fabsf(box.Axes[0].x), fabsf(box.Axes[0].y), fabsf(box.Axes[0].z) }, box.HalfExtents.x),
+        Vector3Scale(Vector3{ fabsf(box.Axes[1].x), fabsf(box.Axes[1].y), fabsf(box.Axes[1].z) }, box.HalfExtents.y)),
+        Vector3Scale(Vector3{ fabsf(box.Axes[2].x), fabsf(box.Axes[2].y), fabsf(box.Axes[2].z) }, box.HalfExtents.z));
+
+    return BoundingBox{ Vector3Subtract(box.Center, extents), Vector3Add(box.Center, extents) };
+}
+
+// check if two oriented boxes overlap using the separating axis test
+// the 3 axes of each box and the 9 cross products between them are the only axes that can separate two boxes
+bool CheckCollisionOrientedBoxes(const OrientedBox& box1, const OrientedBox& box2)
+{
+    // a little slack so nearly parallel edges don't make a bogus cross product axis
+    constexpr float epsilon = 0.00001f;
+
+    float extents1[3] = { box1.HalfExtents.x, box1.HalfExtents.y, box1.HalfExtents.z };
+    float extents2[3] = { box2.HalfExtents.x, box2.HalfExtents.y, box2.HalfExtents.z };
+
+    // the rotation of box2 in box1's space
+    float rotation[3][3];
+    float absRotation[3][3];
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            rotation[i][j] = Vector3DotProduct(box1.Axes[i], box2.Axes[j]);
+            absRotation[i][j] = fabsf(rotation[i][j]) + epsilon;
+        }
+    }
+
+    // the offset between the centers in box1's space
+    Vector3 offset = Vector3Subtract(box2.Center, box1.Center);
+    float translation[3] = { Vector3DotProduct(offset, box1.Axes[0]), Vector3DotProduct(offset, box1.Axes[1]), Vector3DotProduct(offset, box1.Axes[2]) };
+
+    // box1's axes
+    for (int i = 0; i < 3; i++)
+    {
+        float radius2 = extents2[0] * absRotation[i][0] + extents2[1] * absRotation[i][1] + extents2[2] * absRotation[i][2];
+        if (fabsf(translation[i]) > extents1[i] + radius2)
+            return false;
+    }
+
+    // box2's axes
+    for (int j = 0; j < 3; j++)
+    {
+        float radius1 = extents1[0] * absRotation[0][j] + extents1[1] * absRotation[1][j] + extents1[2] * absRotation[2][j];
+        float distance = translation[0] * rotation[0][j] + translation[1] * rotation[1][j] + translation[2] * rotation[2][j];
+        if (fabsf(distance) > radius1 + extents2[j])
+            return false;
+    }
+
+    // the cross products of each pair of axes
+    for (int i = 0; i < 3; i++)
+    {
+        int i1 = (i + 1) % 3;
+        int i2 = (i + 2) % 3;
+
+        for (int j = 0; j < 3; j++)
+        {
+            int j1 = (j + 1) % 3;
+            int j2 = (j + 2) % 3;
+
+            float radius1 = extents1[i1] * absRotation[i2][j] + extents1[i2] * absRotation[i1][j];
+            float radius2 = extents2[j1] * absRotation[i][j2] + extents2[j2] * absRotation[i][j1];
+            float distance = translation[i2] * rotation[i1][j] - translation[i1] * rotation[i2][j];
+            if (fabsf(distance) > radius1 + radius2)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// check if a cylinder hits a bounding box
+bool IntersectBBoxCylinder(BoundingBox bounds, Vector3& center, Vector3 initalPosition, float radius, float height, Vector3& intersectionPoint, Vector3& hitNormal)
+{
+    Rectangle rect = { bounds.min.x, bounds.min.z, bounds.max.x - bounds.min.x, bounds.max.z - bounds.min.z };
+    Vector2 center2d = { center.x, center.z };
+
+    if (!CheckCollisionCircleRec(center2d, radius, rect))
+        return false;
+
+    // we are above or below
+    if (center.y > bounds.max.y)
+        return false;
+
+    if (center.y + height < bounds.min.y)
+        return false;
+
+
+    // see if we landed on top
+    if (center.y <= bounds.max.y && initalPosition.y > bounds.max.y && initalPosition.y > center.y)
+    {
+        // we have hit the top of the obstacle, so clamp our position to where we hit that Y
+        Vector3 movementVec = Vector3Subtract(center, initalPosition);
+
+        float yParam = (initalPosition.y - bounds.max.y) / movementVec.y;
+        movementVec = Vector3Scale(movementVec, yParam);
+        center = Vector3Add(initalPosition, movementVec);
+        intersectionPoint = center;
+        hitNormal = Vector3{ 0,1,0 };
+        return true;
+    }
+
+    // see if we hit the bottom
+    float centerTop = center.y + height;
+    float oldTop = initalPosition.y + height;
+
+    if (centerTop >= bounds.min.y && oldTop < bounds.min.y && initalPosition.y < center.y)
+    {
+        // simple situation of 
+        center = initalPosition;
+        intersectionPoint = center;
+        hitNormal = Vector3{ 0,-1,0 };
+        return true;
+    }
+
+    Vector2 newPosOrigin = { center.x, center.z };
+    Vector2 hitPoint = { std::numeric_limits<float>::min(), std::numeric_limits<float>::min() };
+    Vector2 hitNormal2d = { 0 };
+
+    PointNearestRectanglePoint(rect, newPosOrigin, hitPoint, hitNormal2d);
+
+    Vector2 vectorToHit = Vector2Subtract(hitPoint, newPosOrigin);
+
+    if (Vector2LengthSqr(vectorToHit) >= radius * radius)
+        return false;
+
+    intersectionPoint = Vector3{ hitPoint.x, center.y, hitPoint.y };
+    hitNormal = Vector3{ hitNormal2d.x, 0, hitNormal2d.y };
+
+    // normalize the vector along the point to where we are nearest
+    vectorToHit = Vector2Normalize(vectorToHit);
+
+    // project that out to the radius to find the point that should be 'deepest' into the rectangle.
+    Vector2 projectedPoint = Vector2Add(newPosOrigin, Vector2Scale(vectorToHit, radius));
+
+    // compute the shift to take the deepest point out to the edge of our nearest hit, based on the vector direction
+    Vector2 delta = { 0,0 };
+
+    if (hitNormal.x != 0)
+        delta.x = hitPoint.x - projectedPoint.x;
+    else
+        delta.y = hitPoint.y - projectedPoint.y;
+
+    // shift the new point by the delta to push us outside of the rectangle
+    newPosOrigin = Vector2Add(newPosOrigin, delta);
+
+    center = Vector3{ newPosOrigin.x, center.y, newPosOrigin.y };
+    return true;
+}
+
+// the part of a moving point's path that is inside a rectangle, with the normal of the side it comes in through
+static bool SweepPointRectangle(Vector2 start, Vector2 movement, Vector2 min, Vector2 max, float& enter, float& exit, Vector2& normal)
+{
+    enter = -std::numeric_limits<float>::max();
+    exit = std::numeric_limits<float>::max();
+
+    float origin[2] = { start.x, start.y };
+    float direction[2] = { movement.x, movement.y };
+    float low[2] = { min.x, min.y };
+    float high[2] = { max.x, max.y };
+
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (direction[axis] == 0)
+        {
+            if (origin[axis] < low[axis] || origin[axis] > high[axis])
+                return false;
+            continue;
+        }
+
+        float near = (low[axis] - origin[axis]) / direction[axis];
+        float far = (high[axis] - origin[axis]) / direction[axis];
+        if (near > far)
+            std::swap(near, far);
+
+        if (near > enter)
+        {
+            enter = near;
+            normal = axis == 0 ? Vector2{ direction[0] > 0 ? -1.0f : 1.0f, 0 } : Vector2{ 0, direction[1] > 0 ? -1.0f : 1.0f };
+        }
+        exit = std::min(exit, far);
+    }
+
+    return enter <= exit;
+}
+
+// the part of a moving point's path that is inside a circle
+static bool SweepPointCircle(Vector2 start, Vector2 movement, Vector2 center, float radius, float& enter, float& exit)
+{
+    Vector2 offset = Vector2Subtract(start, center);
+    float a = Vector2DotProduct(movement, movement);
+    float b = 2 * Vector2DotProduct(offset, movement);
+    float c = Vector2DotProduct(offset, offset) - radius * radius;
+
+    if (a == 0)
+    {
+        enter = -std::numeric_limits<float>::max();
+        exit = std::numeric_limits<float>::max();
+        return c <= 0;
+    }
+
+    float discriminant = b * b - 4 * a * c;
+    if (discriminant < 0)
+        return false;
+
+    float root = sqrtf(discriminant);
+    enter = (-b - root) / (2 * a);
+    exit = (-b + root) / (2 * a);
+    return true;
+}
+
+bool SweepCylinderBBox(BoundingBox bounds, Vector3 start, Vector3 movement, float radius, float height, float& hitTime, Vector3& hitNormal)
+{
+    // when the vertical spans overlap, the base has to be below the top of the box and the top above the bottom
+    float enterY = -std::numeric_limits<float>::max();
+    float exitY = std::numeric_limits<float>::max();
+    Vector3 normalY = { 0, movement.y < 0 ? 1.0f : -1.0f, 0 };
+
+    if (movement.y == 0)
+    {
+        if (start.y >= bounds.max.y || start.y + height <= bounds.min.y)
+            return false;
+    }
+    else
+    {
+        float toTop = (bounds.max.y - start.y) / movement.y;
+        float toBottom = (bounds.min.y - height - start.y) / movement.y;
+        enterY = std::min(toTop, toBottom);
+        exitY = std::max(toTop, toBottom);
+    }
+
+    // on the XZ plane the circle hits the box when its center enters the box rounded out by the radius
+    // that shape is two stretched rectangles and a circle on each corner, so the path through it runs from the first entry to the last exit
+    Vector2 start2d = { start.x, start.z };
+    Vector2 movement2d = { movement.x, movement.z };
+    Vector2 min = { bounds.min.x, bounds.min.z };
+    Vector2 max = { bounds.max.x, bounds.max.z };
+
+    float enterXZ = std::numeric_limits<float>::max();
+    float exitXZ = -std::numeric_limits<float>::max();
+    Vector2 normalXZ = { 0 };
+
+    float enter = 0;
+    float exit = 0;
+    Vector2 normal = { 0 };
+
+    Vector2 stretchedMin[2] = { { min.x - radius, min.y }, { min.x, min.y - radius } };
+    Vector2 stretchedMax[2] = { { max.x + radius, max.y }, { max.x, max.y + radius } };
+    for (int i = 0; i < 2; i++)
+    {
+        if (!SweepPointRectangle(start2d, movement2d, stretchedMin[i], stretchedMax[i], enter, exit, normal))
+            continue;
+
+        if (enter < enterXZ)
+        {
+            enterXZ = enter;
+            normalXZ = normal;
+        }
+        exitXZ = std::max(exitXZ, exit);
+    }
+
+    Vector2 corners[4] = { min, { max.x, min.y }, { min.x, max.y }, max };
+    for (const Vector2& corner : corners)
+    {
+        if (!SweepPointCircle(start2d, movement2d, corner, radius, enter, exit))
+            continue;
+
+        if (enter < enterXZ)
+        {
+            enterXZ = enter;
+            normalXZ = Vector2Normalize(Vector2Subtract(Vector2Add(start2d, Vector2Scale(movement2d, enter)), corner));
+        }
+        exitXZ = std::max(exitXZ, exit);
+    }
+
+    if (enterXZ > exitXZ)
+        return false;
+
+    // the cylinder is only touching the box while it overlaps on both
+    float hitEnter = std::max(enterXZ, enterY);
+    float hitExit = std::min(exitXZ, exitY);
+    if (hitEnter > hitExit || hitEnter > 1 || hitExit < 0)
+        return false;
+
+    if (hitEnter < 0)
+    {
+        // already touching, which happens when sliding along a wall, so only stop movement that goes further in
+        Vector2 nearest = { Clamp(start2d.x, min.x, max.x), Clamp(start2d.y, min.y, max.y) };
+        Vector2 away = Vector2Subtract(start2d, nearest);
+
+        // a center inside the box is too deep to slide, that is left for the push out
+        if (Vector2LengthSqr(away) == 0)
+            return false;
+
+        away = Vector2Normalize(away);
+        if (Vector2DotProduct(movement2d, away) >= 0)
+            return false;
+
+        hitTime = 0;
+        hitNormal = Vector3{ away.x, 0, away.y };
+        return true;
+    }
+
+    hitTime = hitEnter;
+    if (enterXZ >= enterY)
+        hitNormal = Vector3{ normalXZ.x, 0, normalXZ.y };
+    else
+        hitNormal = normalY;
+
+    return true;
+}
+
+// how far along a ray it first is inside a box, starting inside counts as zero
+static bool RayEnterBox(const float origin[3], const float direction[3], const float low[3], const float high[3], float maxDistance, float& enter)
+{
+    float near = 0;
+    float far = maxDistance;
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        if (direction[axis] == 0)
+        {
+            if (origin[axis] < low[axis] || origin[axis] > high[axis])
+                return false;
+            continue;
+        }
+
+        float inverse = 1.0f / direction[axis];
+        float t1 = (low[axis] - origin[axis]) * inverse;
+        float t2 = (high[axis] - origin[axis]) * inverse;
+        near = std::max(near, std::min(t1, t2));
+        far = std::min(far, std::max(t1, t2));
+        if (near > far)
+            return false;
+    }
+
+    enter = near;
+    return true;
+}
+
+// how far along a ray with a unit direction it first is inside a sphere
+static bool RayEnterSphere(const float origin[3], const float direction[3], const float center[3], float radius, float& enter)
+{
+    float offset[3] = { origin[0] - center[0], origin[1] - center[1], origin[2] - center[2] };
+    float b = offset[0] * direction[0] + offset[1] * direction[1] + offset[2] * direction[2];
+    float c = offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2] - radius * radius;
+
+    if (c <= 0)
+    {
+        enter = 0;
+        return true;
+    }
+
+    // outside and moving away
+    if (b > 0)
+        return false;
+
+    float discriminant = b * b - c;
+    if (discriminant < 0)
+        return false;
+
+    enter = -b - sqrtf(discriminant);
+    return true;
+}
+
+// how far along a ray it first is inside a cylinder around a box edge, the ends are left to the corner spheres
+static bool RayEnterEdge(const float origin[3], const float direction[3], int axis, float position1, float position2, float low, float high, float radius, float& enter)
+{
+    int axis1 = (axis + 1) % 3;
+    int axis2 = (axis + 2) % 3;
+
+    float offset1 = origin[axis1] - position1;
+    float offset2 = origin[axis2] - position2;
+    float a = direction[axis1] * direction[axis1] + direction[axis2] * direction[axis2];
+    float b = offset1 * direction[axis1] + offset2 * direction[axis2];
+    float c = offset1 * offset1 + offset2 * offset2 - radius * radius;
+
+    float t = 0;
+    if (c > 0)
+    {
+        if (a == 0 || b > 0)
+            return false;
+
+        float discriminant = b * b - a * c;
+        if (discriminant < 0)
+            return false;
+
+        t = (-b - sqrtf(discriminant)) / a;
+    }
+
+    float along = origin[axis] + direction[axis] * t;
+    if (along < low || along > high)
+        return false;
+
+    enter = t;
+    return true;
+}
+
+bool SphereCastBBox(BoundingBox bounds, Ray ray, float radius, float maxDistance, float& distance, Vector3& hitNormal)
+{
+    float origin[3] = { ray.position.x, ray.position.y, ray.position.z };
+    float direction[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+    float low[3] = { bounds.min.x, bounds.min.y, bounds.min.z };
+    float high[3] = { bounds.max.x, bounds.max.y, bounds.max.z };
+
+    // most boxes are missed by the box grown by the radius on every side, which is cheap to test
+    float grownLow[3] = { low[0] - radius, low[1] - radius, low[2] - radius };
+    float grownHigh[3] = { high[0] + radius, high[1] + radius, high[2] + radius };
+    float enter = 0;
+    if (!RayEnterBox(origin, direction, grownLow, grownHigh, maxDistance, enter))
+        return false;
+
+    // the sphere touches the box when its center enters the box rounded out by the radius
+    // that shape is the box grown along each axis in turn, a cylinder on each edge and a sphere on each corner
+    float hitDistance = std::numeric_limits<float>::max();
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        float faceLow[3] = { low[0], low[1], low[2] };
+        float faceHigh[3] = { high[0], high[1], high[2] };
+        faceLow[axis] -= radius;
+        faceHigh[axis] += radius;
+
+        if (RayEnterBox(origin, direction, faceLow, faceHigh, maxDistance, enter))
+            hitDistance = std::min(hitDistance, enter);
+    }
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        int axis1 = (axis + 1) % 3;
+        int axis2 = (axis + 2) % 3;
+        for (int edge = 0; edge < 4; edge++)
+        {
+            float position1 = (edge & 1) ? high[axis1] : low[axis1];
+            float position2 = (edge & 2) ? high[axis2] : low[axis2];
+            if (RayEnterEdge(origin, direction, axis, position1, position2, low[axis], high[axis], radius, enter))
+                hitDistance = std::min(hitDistance, enter);
+        }
+    }
+
+    for (int corner = 0; corner < 8; corner++)
+    {
+        float center[3] = { (corner & 1) ? high[0] : low[0], (corner & 2) ? high[1] : low[1], (corner & 4) ? high[2] : low[2] };
+        if (RayEnterSphere(origin, direction, center, radius, enter))
+            hitDistance = std::min(hitDistance, enter);
+    }
+
+    if (hitDistance > maxDistance)
+        return false;
+
+    distance = hitDistance;
+
+    // the normal points from the nearest point on the box to the sphere center
+    Vector3 center = Vector3Add(ray.position, Vector3Scale(ray.direction, distance));
+    Vector3 nearest = { Clamp(center.x, low[0], high[0]), Clamp(center.y, low[1], high[1]), Clamp(center.z, low[2], high[2]) };
+    Vector3 away = Vector3Subtract(center, nearest);
+
+    float length = Vector3Length(away);
+    if (length > 0)
+        hitNormal = Vector3Scale(away, 1.0f / length);
+    else
+        hitNormal = Vector3Negate(ray.direction);   // started with the center inside the box, push straight back
+
+    return true;
+}
+
+/// <summary>
+/// Returns the point on a rectangle that is nearest to a provided point
+/// </summary>
+/// <param name="rect">The rectangle to test against</param>
+/// <param name="point">The point you want to start from</param>
+/// <param name="nearest">A pointer that will be filed out with the point on the rectangle that is nearest to your passed in point</param>
+/// <param name="normal">A pointer that will be filed out with the the normal of the edge the nearest point is on</param>
+void PointNearestRectanglePoint(Rectangle rect, Vector2 point, Vector2& nearest, Vector2& normal)
+{
+    // get the closest point on the vertical sides
+    float hValue = rect.x;
+    float hNormal = -1;
+    if (point.x > rect.x + rect.width)
+    {
+        hValue = rect.x + rect.width;
+        hNormal = 1;
+    }
+
+    Vector2 vecToPoint = Vector2Subtract(Vector2{ hValue, rect.y }, point);
+    // get the dot product between the ray and the vector to the point
+    float dotForPoint = Vector2DotProduct(Vector2{ 0, -1 }, vecToPoint);
+    Vector2 nearestPoint = { hValue, 0 };
+
+    if (dotForPoint < 0)
+        nearestPoint.y = rect.y;
+    else if (dotForPoint >= rect.height)
+        nearestPoint.y = rect.y + rect.height;
+    else
+        nearestPoint.y = rect.y + dotForPoint;
+
+    // get the closest point on the horizontal sides
+    float vValue = rect.y;
+    float vNormal = -1;
+    if (point.y > rect.y + rect.height)
+    {
+        vValue = rect.y + rect.height;
+        vNormal = 1;
+    }
+
+    vecToPoint = Vector2Subtract(Vector2{ rect.x, vValue }, point);
+    // get the dot product between the ray and the vector to the point
+    dotForPoint = Vector2DotProduct(Vector2{ -1, 0 }, vecToPoint);
+    nearest = Vector2{ 0,vValue };
+
+    if (dotForPoint < 0)
+        nearest.x = rect.x;
+    else if (dotForPoint >= rect.width)
+        nearest.x = rect.x + rect.width;
+    else
+        nearest.x = rect.x + dotForPoint;
+
+    if (Vector2LengthSqr(Vector2Subtract(point, nearestPoint)) <= Vector2LengthSqr(Vector2Subtract(point, nearest)))
+    {
+        nearest = nearestPoint;
+        normal.x = hNormal;
+        normal.y = 0;
+    }
+    else
+    {
+        normal.y = vNormal;
+        normal.x = 0;
+    }
+}
\ No newline at end of file
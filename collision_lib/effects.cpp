@@ -0,0 +1,131 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include "effects.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+// how many quads are sent to rlgl between checks that the batch has room for them
+static constexpr size_t QuadsPerBatchCheck = 1024;
+
+ExplosionPool::ExplosionPool()
+{
+    Positions.resize(Capacity);
+    Normals.resize(Capacity);
+    Lifetimes.resize(Capacity);
+}
+
+void ExplosionPool::Add(Vector3 position, Vector3 normal)
+{
+    if (Count == Capacity)
+        return;
+
+    Positions[Count] = position;
+    Normals[Count] = normal;
+    Lifetimes[Count] = MaxLife;
+    Count++;
+}
+
+void ExplosionPool::Clear()
+{
+    Count = 0;
+}
+
+void ExplosionPool::Update(float deltaTime)
+{
+    size_t index = 0;
+    while (index < Count)
+    {
+        Lifetimes[index] -= deltaTime;
+        if (Lifetimes[index] > 0)
+        {
+            index++;
+            continue;
+        }
+
+        // move the last effect into this slot and check it next
+        Count--;
+        Positions[index] = Positions[Count];
+        Normals[index] = Normals[Count];
+        Lifetimes[index] = Lifetimes[Count];
+    }
+}
+
+void ExplosionPool::Draw(const Camera3D& view, Texture2D texture) const
+{
+    if (Count == 0)
+        return;
+
+    // the quads face the camera, so get the camera's right and up vectors from the view matrix
+    Matrix viewMatrix = MatrixLookAt(view.position, view.target, view.up);
+    Vector3 right = { viewMatrix.m0, viewMatrix.m4, viewMatrix.m8 };
+    Vector3 up = { viewMatrix.m1, viewMatrix.m5, viewMatrix.m9 };
+
+    rlSetTexture(texture.id);
+
+    for (size_t start = 0; start < Count; start += QuadsPerBatchCheck)
+    {
+        size_t end = start + QuadsPerBatchCheck;
+        if (end > Count)
+            end = Count;
+
+        // flush the batch first if this group of quads won't fit in it
+        rlCheckRenderBatchLimit(int(end - start) * 4);
+
+        rlBegin(RL_QUADS);
+        for (size_t i = start; i < end; i++)
+        {
+            float param = Lifetimes[i] / MaxLife;
+            float size = 0.125f + ((1.0f - param) * 0.5f);
+
+            // push the quad out of the surface by half its size so the wall doesn't cut it off
+            Vector3 center = Vector3Add(Positions[i], Vector3Scale(Normals[i], size * 0.5f));
+            Vector3 x = Vector3Scale(right, size);
+            Vector3 y = Vector3Scale(up, size);
+
+            Vector3 topLeft = Vector3Add(Vector3Subtract(center, x), y);
+            Vector3 bottomLeft = Vector3Subtract(Vector3Subtract(center, x), y);
+            Vector3 bottomRight = Vector3Subtract(Vector3Add(center, x), y);
+            Vector3 topRight = Vector3Add(Vector3Add(center, x), y);
+
+            rlColor4ub(ORANGE.r, ORANGE.g, ORANGE.b, (unsigned char)(param * 255));
+
+            rlTexCoord2f(0, 0);
+            rlVertex3f(topLeft.x, topLeft.y, topLeft.z);
+            rlTexCoord2f(0, 1);
+            rlVertex3f(bottomLeft.x, bottomLeft.y, bottomLeft.z);
+            rlTexCoord2f(1, 1);
+            rlVertex3f(bottomRight.x, bottomRight.y, bottomRight.z);
+            rlTexCoord2f(1, 0);
+            rlVertex3f(topRight.x, topRight.y, topRight.z);
+        }
+        rlEnd();
+    }
+
+    rlSetTexture(0);
+}
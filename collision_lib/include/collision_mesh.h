@@ -0,0 +1,94 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <vector>
+
+// Static level geometry as a list of world space triangles, with a bounding volume hierarchy over them.
+// Rays and player cylinders only look at the triangles in the BVH nodes they touch.
+class CollisionMesh
+{
+public:
+    static constexpr int MaxLeafTriangles = 4;
+    static constexpr int MaxPushPasses = 4;
+
+    void Clear();
+
+    // add every triangle of a mesh, moved into world space by the transform
+    void AddMesh(const Mesh& mesh, Matrix transform);
+
+    // add every mesh of a model using the model's own transform
+    void AddModel(const Model& model);
+
+    // build the BVH, call after adding meshes and before any queries
+    void Build();
+
+    bool IsEmpty() const { return Nodes.empty(); }
+    size_t GetTriangleCount() const { return Triangles.size(); }
+    size_t GetNodeCount() const { return Nodes.size(); }
+
+    // find the closest triangle hit nearer than maxDistance, the distance and normal are in world space
+    // the normal always faces back along the ray, and this is safe to call from several threads at once
+    bool CollideRay(Ray ray, RayCollision& collision, float maxDistance) const;
+
+    // push a standing cylinder out of any triangles it overlaps, the position is the center of the bottom
+    // triangles are only pushed against sideways, and ones flat at the feet or head don't count
+    bool CollideCylinder(Vector3& position, float radius, float height);
+
+    // move a cylinder in steps small enough that it can't pass through a triangle, pushing out along the way
+    bool MoveCylinder(Vector3& newPosition, Vector3 oldPosition, float radius, float height);
+
+    // get the triangles in every BVH leaf that overlaps the box
+    void QueryBounds(const BoundingBox& box, std::vector<int>& results) const;
+
+private:
+    struct Triangle
+    {
+        Vector3 A = { 0 };
+        Vector3 B = { 0 };
+        Vector3 C = { 0 };
+    };
+
+    // a node with a count is a leaf over Triangles[First, First + Count)
+    // otherwise its children are Nodes[First] and Nodes[First + 1]
+    struct Node
+    {
+        BoundingBox Bounds = { 0 };
+        int First = 0;
+        int Count = 0;
+    };
+
+    std::vector<Triangle> Triangles;
+    std::vector<Node> Nodes;
+    std::vector<int> Candidates;
+
+    void BuildNode(int nodeIndex, int first, int count, std::vector<Vector3>& centers);
+};
@@ -0,0 +1,59 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "raylib.h"
+
+// the SIMD collision tests use SSE2 when the compiler targets it, and plain loops when it doesn't
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_USE_SSE2
+#endif
+
+// a box with its own axes, in the space the axes are given in
+struct OrientedBox
+{
+    Vector3 Center = { 0 };
+    Vector3 Axes[3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    Vector3 HalfExtents = { 0 };
+};
+
+OrientedBox OrientedBoxFromBounds(BoundingBox bounds, const Matrix& transform);
+BoundingBox GetOrientedBoxBounds(const OrientedBox& box);
+bool CheckCollisionOrientedBoxes(const OrientedBox& box1, const OrientedBox& box2);
+
+void PointNearestRectanglePoint(Rectangle rect, Vector2 point, Vector2& nearest, Vector2& normal);
+bool IntersectBBoxCylinder(BoundingBox bounds, Vector3& center, Vector3 initalPosition, float radius, float height, Vector3& intersectionPoint, Vector3& hitNormal);
+
+// find when a cylinder moving from start by movement first touches a bounding box, the cylinder stands on start and goes up by height
+// hitTime is the fraction of the movement, a cylinder that starts out touching the box only hits it when moving further in
+bool SweepCylinderBBox(BoundingBox bounds, Vector3 start, Vector3 movement, float radius, float height, float& hitTime, Vector3& hitNormal);
+
+// find how far a sphere moving along a ray first touches a bounding box, the ray direction must be normalized
+// a sphere that starts out touching the box hits at zero distance, misses further away than maxDistance are ignored
+bool SphereCastBBox(BoundingBox bounds, Ray ray, float radius, float maxDistance, float& distance, Vector3& hitNormal);
@@ -29,6 +29,34 @@
 #pragma once
 
 #include "raylib.h"
+#include <cstddef>
+#include <vector>
 
-void PointNearestRectanglePoint(Rectangle rect, Vector2 point, Vector2& nearest, Vector2& normal);
-bool IntersectBBoxCylinder(BoundingBox bounds, Vector3& center, Vector3 initalPosition, float radius, float height, Vector3& intersectionPoint, Vector3& hitNormal);
\ No newline at end of file
+// A fixed size pool of short lived impact effects.
+// Each value is kept in its own array so aging walks tight memory, and dead effects are swapped with the last live one.
+// Nothing is allocated after construction, when the pool is full new effects are dropped.
+class ExplosionPool
+{
+public:
+    static constexpr size_t Capacity = 16384;
+    static constexpr float MaxLife = 0.25f;
+
+    ExplosionPool();
+
+    void Add(Vector3 position, Vector3 normal);
+    void Clear();
+
+    // age every effect and remove the ones that have run out
+    void Update(float deltaTime);
+
+    // draw every effect as a camera facing quad, in as few batches as rlgl allows
+    void Draw(const Camera3D& view, Texture2D texture) const;
+
+    size_t GetCount() const { return Count; }
+
+private:
+    std::vector<Vector3> Positions;
+    std::vector<Vector3> Normals;
+    std::vector<float> Lifetimes;
+    size_t Count = 0;
+};
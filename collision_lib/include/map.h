@@ -0,0 +1,199 @@
+
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "collision_mesh.h"
+#include "collisions.h"
+#include "effects.h"
+#include "object_transform.h"
+#include "obstacle_grid.h"
+#include "obstacle_store.h"
+#include "thread_pool.h"
+#include "wall_packets.h"
+#include <vector>
+#include <memory>
+
+inline BoundingBox operator + (const BoundingBox& lhs, const Vector3& rhs)
+{
+    return BoundingBox{ lhs.min - rhs, lhs.max + rhs };
+}
+
+inline BoundingBox operator + (const BoundingBox& lhs, const float& rhs)
+{
+    return BoundingBox{ lhs.min - Vector3{rhs,rhs,rhs}, lhs.max + Vector3{rhs, rhs,rhs} };
+}
+
+class Obstacle
+{
+public:
+    ObjectTransform Transform;
+    Vector3 Scale = { 1, 1, 1 };
+    Color Tint = DARKGREEN;
+
+    Vector3 thing{ 1,2,2 };
+
+    Vector3 LastNearestPoint = { 0,0 };
+
+    BoundingBox Bounds = { 0 };
+
+    Obstacle() = default;
+    Obstacle(float x, float z, float width, float height, float depth, float angle);
+    bool CollideWithPlayer(Vector3& newPosition, Vector3 oldPosition, float radius, float height);
+    bool SweepPlayer(Vector3 position, Vector3 movement, float radius, float height, float& hitTime, Vector3& hitNormal);
+
+    // refresh the cached matrices and world box, call after moving the transform (Map::WallsChanged does this for map walls)
+    void UpdateTransformCache();
+
+    const OrientedBox& GetWorldBox();
+    const Matrix& GetWorldMatrix();
+    const Matrix& GetInverseWorldMatrix();
+    BoundingBox GetWorldBounds();
+
+    bool CheckRaycast(Ray worldRay, RayCollision& collision, float radius = 0);
+
+    // the same test on the cached matrices and box as they are, it never checks the transform, so threads can share the wall
+    // call UpdateTransformCache or any of the getters after the wall moves, Map::CollideRays does this before starting its workers
+    bool CheckRaycastCached(Ray worldRay, RayCollision& collision, float radius = 0) const;
+    // move a sphere along a ray with a normalized direction, see SphereCastBBox
+    bool SphereCast(Ray worldRay, float radius, float maxDistance, float& distance, Vector3& hitNormal);
+
+private:
+    // walls almost never move, so the matrices and box are only rebuilt when the transform changes
+    Matrix WorldMatrix = MatrixIdentity();
+    Matrix InverseWorldMatrix = MatrixIdentity();
+    OrientedBox WorldBox;
+    unsigned int TransformVersion = 0;
+
+    void CheckTransformCache();
+};
+
+class Map
+{
+public:
+    std::vector<Obstacle> Walls;
+    ExplosionPool Explosions;
+
+    // static level geometry loaded from models, collided with as triangles
+    CollisionMesh LevelMesh;
+
+    // when set, rays also hit an endless floor at zero height
+    bool FloorCollisions = false;
+
+    static void SetupGraphics();
+    static void CleanupGraphics();
+    static Shader GetLightShader();
+
+    void Setup();
+    void Cleanup();
+
+    // load a model as static level geometry, it is drawn with the map and added to the level collision mesh
+    bool LoadLevelModel(const char* fileName, Matrix transform);
+
+    bool CollidePlayer(Vector3& newPosition, Vector3 oldPosition, float radius, float height);
+
+    // move the player cylinder from the old position toward the new one, stopping at walls and sliding along them
+    // unlike CollidePlayer this can't skip through thin walls, no matter how far the player moves in one step
+    bool MovePlayer(Vector3& newPosition, Vector3 oldPosition, float radius, float height);
+    // a radius grows the walls and floor so the ray acts like a thick ray, the level mesh is always hit by the thin ray
+    // hitObstacle is set to the wall that was hit, or null when the ray hit nothing or the hit was the level mesh or floor
+    bool CollideRay(Ray worldspaceRay, RayCollision& outputCollision, Obstacle** hitObstacle = nullptr, float radius = 0);
+
+    // cast a batch of rays, each result matches what CollideRay would give for that ray with the same radius
+    // thin rays slab test the walls in SIMD packets, then the level mesh is checked up to the wall that was hit
+    // the packets only hold the walls' own bounds, so rays with a radius walk the grid and test one wall at a time like CollideRay
+    // big batches are split across worker threads, the walls and their transform graph are updated on this thread first
+    void CollideRays(const Ray* worldspaceRays, RayCollision* outputCollisions, size_t count, float radius = 0);
+
+    // move a sphere along a ray with a normalized direction until it first touches something, up to maxDistance
+    // the hit point is where the center of the sphere stops, only walls near the swept sphere are tested
+    // the level mesh is hit by the thin ray, and the sphere is stopped a radius short of it
+    bool SphereCast(Ray worldspaceRay, float radius, float maxDistance, RayCollision& outputCollision);
+
+    // advance anything in the map that changes over time, called once per simulation tick
+    void Update(float deltaTime);
+
+    void Draw(Camera3D& view);
+    void DrawWalls(Camera3D& view);
+
+    void AddExplosition(RayCollision& collision);
+
+    void AddShotSound();
+
+    // call after adding, moving or removing walls so the broadphase grid and wall transforms are rebuilt
+    void WallsChanged();
+
+private:
+    static constexpr int MaxSlides = 4;
+    static constexpr float SlideSkin = 0.001f;
+
+    static constexpr size_t RaysPerTask = 256;
+    static constexpr size_t ThreadedRayBatch = RaysPerTask * 8;
+
+    ObstacleGrid WallGrid;
+    WallPackets WallRayPackets;
+    ObstacleStore WallStore;
+    bool WallGridDirty = true;
+    std::vector<int> WallCandidates;
+
+    std::unique_ptr<ThreadPool> RayWorkers;
+
+    std::vector<Model> LevelModels;
+
+    void UpdateWallGrid();
+
+    // bring every wall's cached matrices up to date with its transform, so threads can read them without writing anything
+    void UpdateWallCaches();
+
+    // find the nearest wall a ray hits using the cached wall matrices, so it can run on any thread after UpdateWallCaches
+    // returns the index of the wall, or -1 if no wall was hit
+    int CollideWallsCached(Ray worldspaceRay, RayCollision& outputCollision, float radius, std::vector<int>& candidates) const;
+
+    // replace a ray hit with a closer one on the level mesh, if there is one
+    void CollideLevelMesh(Ray worldspaceRay, RayCollision& collision) const;
+    void CollideFloor(Ray worldspaceRay, RayCollision& outputCollision, float radius) const;
+
+    // transforms for the instanced wall draw, only rebuilt when the walls change
+    std::vector<Matrix> WallTransforms;
+    bool WallTransformsDirty = true;
+
+    void UpdateWallTransforms();
+
+    static constexpr int MaxSounds = 32;
+
+    Sound ShotSound = { 0 };
+    Sound ShotLoop[MaxSounds] = { 0 };
+    int CurrentShotSound = 0;
+};
+
+
+void BuildDemoMap(Map& map);
+
+// needs graphics, the level models are drawn as well as collided with
+void BuildDemoLevel(Map& map);
\ No newline at end of file
@@ -0,0 +1,476 @@
+/**********************************************************************************************
+*
+*   object_transform.h * a sample 3d object transfrom class
+*
+*   LICENSE: ZLIB
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "transform_graph.h"
+
+#include <vector>
+#include <algorithm>
+
+class ObjectTransform
+{
+private:
+    Vector3 Position = { 0 };
+    Quaternion Orientation = QuaternionIdentity();
+
+    bool Dirty = true;
+
+    // goes up every time the world matrix changes, see GetWorldVersion
+    unsigned int WorldVersion = 0;
+
+    Matrix WorldMatrix = { 0 };
+    Matrix GlWorldMatrix = { 0 };
+
+    ObjectTransform* Parent = nullptr;
+    std::vector<ObjectTransform*> Children;
+
+    // when set, the position, orientation and world matrix live in a node of this graph and the transform is just a handle to it
+    TransformGraph* Graph = nullptr;
+    int GraphNode = TransformGraph::NoParent;
+
+    // the H, V and D vectors of the orientation, only worked out again after the orientation changes
+    mutable Vector3 LocalBasis[3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    mutable bool LocalBasisDirty = true;
+
+    // the axes the orientation turns the unit X, Y and Z vectors to, read straight from the quaternion
+    static void GetBasis(const Quaternion& q, Vector3 basis[3])
+    {
+        basis[0] = Vector3{ 1 - 2 * (q.y * q.y + q.z * q.z), 2 * (q.x * q.y - q.w * q.z), 2 * (q.x * q.z + q.w * q.y) };
+        basis[1] = Vector3{ 2 * (q.x * q.y + q.w * q.z), 1 - 2 * (q.x * q.x + q.z * q.z), 2 * (q.y * q.z - q.w * q.x) };
+        basis[2] = Vector3{ 2 * (q.x * q.z - q.w * q.y), 2 * (q.y * q.z + q.w * q.x), 1 - 2 * (q.x * q.x + q.y * q.y) };
+    }
+
+    const Vector3* GetLocalBasis() const
+    {
+        // the graph can be changed without going through this handle, so there the basis is always worked out
+        if (Graph || LocalBasisDirty)
+        {
+            GetBasis(GetOrientation(), LocalBasis);
+            LocalBasisDirty = Graph != nullptr;
+        }
+
+        return LocalBasis;
+    }
+
+public:
+
+    ObjectTransform(bool faceY = true)
+    {
+        if (faceY)
+            Orientation = QuaternionFromAxisAngle(Vector3{ 0,1,0 }, 0);
+    }
+
+    virtual ~ObjectTransform() = default;
+
+    ObjectTransform* GetParent() const { return Parent; }
+
+    const std::vector<ObjectTransform*>& GetChildren() const { return Children; }
+
+    const Quaternion& GetOrientation() const { return Graph ? Graph->GetOrientation(GraphNode) : Orientation; }
+
+    TransformGraph* GetGraph() const { return Graph; }
+    int GetGraphNode() const { return GraphNode; }
+
+    // move this transform and everything under it into a graph
+    // from then on changes only flag the graph, and world matrices are updated for the whole graph in one pass
+    void MoveToGraph(TransformGraph& graph)
+    {
+        if (Graph == &graph)
+            return;
+
+        // the graph update can only follow a parent in the same graph, so the whole hierarchy moves in from the top, bringing this with it
+        if (Parent && Parent->Graph != &graph)
+        {
+            Parent->MoveToGraph(graph);
+            return;
+        }
+
+        Vector3 position = GetPosition();
+        Quaternion orientation = GetOrientation();
+
+        GraphNode = graph.AddNode(Parent ? Parent->GraphNode : TransformGraph::NoParent, GetWorldVersion());
+        Graph = &graph;
+        Graph->SetPosition(GraphNode, position);
+        Graph->SetOrientation(GraphNode, orientation);
+
+        for (ObjectTransform* childTransform : Children)
+        {
+            if (childTransform != nullptr)
+                childTransform->MoveToGraph(graph);
+        }
+    }
+
+    ObjectTransform* AddChild(ObjectTransform* child)
+    {
+        if (!child)
+            return nullptr;
+
+        child->Reparent(this);
+
+        return child;
+    }
+
+    ObjectTransform& AddChild(ObjectTransform& child)
+    {
+        child.Reparent(this);
+
+        return child;
+    }
+
+    void Reparent(ObjectTransform* newParent)
+    {
+        if (Parent == newParent)
+            return;
+
+        if (Parent)
+        {
+            auto child = std::find(Parent->Children.begin(), Parent->Children.end(), this);
+            if (child != Parent->Children.end())
+                Parent->Children.erase(child);
+        }
+
+        Parent = newParent;
+        if (Parent)
+            Parent->Children.push_back(this);
+
+        // a child of a node in a graph joins the graph, so the graph update follows its parent
+        // a node in a graph put under a parent outside of it pulls the parent's hierarchy into the graph for the same reason
+        if (Parent && Parent->Graph && Parent->Graph != Graph)
+            MoveToGraph(*Parent->Graph);
+        else if (Graph)
+        {
+            if (Parent && Parent->Graph != Graph)
+                Parent->MoveToGraph(*Graph);
+
+            Graph->SetParent(GraphNode, Parent ? Parent->GraphNode : TransformGraph::NoParent);
+        }
+        else
+            SetDirty();
+    }
+
+    void Detach()
+    {
+        if (!GetParent())
+            return;
+
+        Matrix worldTransform = GetWorldMatrix();
+        Vector3 position = Vector3Transform(Vector3Zero(), worldTransform);
+        Quaternion orientation = QuaternionFromMatrix(worldTransform);
+
+        Reparent(nullptr);
+
+        SetPosition(position);
+        SetOrientation(orientation);
+    }
+
+    void SetDirty()
+    {
+        if (Graph)
+        {
+            // the graph update takes care of the children
+            Graph->SetChanged(GraphNode);
+            return;
+        }
+
+        Dirty = true;
+        WorldVersion++;
+        for (ObjectTransform* childTransform : Children)
+        {
+            if (childTransform != nullptr)
+                childTransform->SetDirty();
+        }
+    }
+
+    const Vector3& GetPosition() const { return Graph ? Graph->GetPosition(GraphNode) : Position; }
+
+    Vector3 GetEulerAngles() const
+    {
+        return QuaternionToEuler(GetOrientation());
+    }
+
+    Vector3 GetDVector() const
+    {
+        return GetLocalBasis()[2];
+    }
+
+    Vector3 GeVVector() const
+    {
+        return GetLocalBasis()[1];
+    }
+
+    Vector3 GetHNegVector() const
+    {
+        return GetLocalBasis()[0];
+    }
+
+    Vector3 GetHPosVector() const
+    {
+        return Vector3Negate(GetLocalBasis()[0]);
+    }
+
+    // the same vectors in world space, read from the world matrix
+    Vector3 GetWorldDVector()
+    {
+        const Matrix& worldMatrix = GetWorldMatrix();
+        return Vector3{ worldMatrix.m8, worldMatrix.m9, worldMatrix.m10 };
+    }
+
+    Vector3 GetWorldVVector()
+    {
+        const Matrix& worldMatrix = GetWorldMatrix();
+        return Vector3{ worldMatrix.m4, worldMatrix.m5, worldMatrix.m6 };
+    }
+
+    Vector3 GetWorldHNegVector()
+    {
+        const Matrix& worldMatrix = GetWorldMatrix();
+        return Vector3{ worldMatrix.m0, worldMatrix.m1, worldMatrix.m2 };
+    }
+
+    Vector3 GetWorldPosition()
+    {
+        return Vector3Transform(Vector3Zero(), GetWorldMatrix());
+    }
+
+    Vector3 GetWorldTargetPoint()
+    {
+        return Vector3Transform(Vector3{ 0,1,0 }, GetWorldMatrix());
+    }
+
+    void SetPosition(float x, float y, float z)
+    {
+        SetPosition(Vector3{ x, y, z });
+    }
+
+    void MovePosition(float x, float y, float z)
+    {
+        SetPosition(Vector3Add(GetPosition(), Vector3{ x, y, z }));
+    }
+
+    void SetPosition(const Vector3& pos)
+    {
+        if (Graph)
+        {
+            Graph->SetPosition(GraphNode, pos);
+            return;
+        }
+
+        Position = pos;
+        SetDirty();
+    }
+
+    void SetOrientation(const Vector3& eulerAngles)
+    {
+        Vector3 angles = Vector3Scale(eulerAngles, DEG2RAD);
+        SetOrientation(QuaternionFromEuler(angles.x, angles.y, angles.z));
+    }
+
+    void SetOrientation(const Quaternion& orientation)
+    {
+        if (Graph)
+        {
+            Graph->SetOrientation(GraphNode, orientation);
+            return;
+        }
+
+        Orientation = orientation;
+        LocalBasisDirty = true;
+        SetDirty();
+    }
+
+    // true when the world matrix has to be worked out again before it is read
+    bool IsDirty() const
+    {
+        return Graph ? Graph->IsChanged(GraphNode) : Dirty;
+    }
+
+    // goes up every time this transform's world matrix changes, even when something else reads the new matrix first
+    // keep the version with anything worked out from the world matrix, and work it out again when the version is different
+    unsigned int GetWorldVersion()
+    {
+        return Graph ? Graph->GetVersion(GraphNode) : WorldVersion;
+    }
+
+    void LookAt(const Vector3& target, const Vector3& up)
+    {
+        Matrix mat = MatrixLookAt(GetPosition(), target, up);
+        SetOrientation(QuaternionFromMatrix(mat));
+    }
+
+    Matrix GetLocalMatrix() const
+    {
+        return TransformLocalMatrix(GetPosition(), GetOrientation());
+    }
+
+    void UpdateWorldMatrix()
+    {
+        if (Graph)
+        {
+            Graph->UpdateWorldMatrices();
+            return;
+        }
+
+        Matrix parentMatrix = MatrixIdentity();
+
+        if (Parent)
+            parentMatrix = Parent->GetWorldMatrix();
+
+        WorldMatrix = MatrixMultiply(GetLocalMatrix(), parentMatrix);
+        GlWorldMatrix = MatrixTranspose(WorldMatrix);
+
+        Dirty = false;
+    }
+
+    const Matrix& GetWorldMatrix()
+    {
+        if (Graph)
+            return Graph->GetWorldMatrix(GraphNode);
+
+        if (!IsDirty())
+            return WorldMatrix;
+
+        UpdateWorldMatrix();
+        return WorldMatrix;
+    }
+
+    const Matrix& GetGLWorldMatrix()
+    {
+        if (Graph)
+        {
+            GlWorldMatrix = MatrixTranspose(Graph->GetWorldMatrix(GraphNode));
+            return GlWorldMatrix;
+        }
+
+        if (!IsDirty())
+            return GlWorldMatrix;
+
+        UpdateWorldMatrix();
+        return GlWorldMatrix;
+    }
+
+    Vector3 ToLocalPos(const Vector3& inPos)
+    {
+        return Vector3Transform(inPos, MatrixInvert(GetWorldMatrix()));
+    }
+
+    void MoveV(float distance)
+    {
+        SetPosition(Vector3Add(GetPosition(), Vector3Scale(GeVVector(), distance)));
+    }
+
+    void MoveD(float distance)
+    {
+        SetPosition(Vector3Add(GetPosition(), Vector3Scale(GetDVector(), distance)));
+    }
+
+    void MoveH(float distance)
+    {
+        SetPosition(Vector3Add(GetPosition(), Vector3Scale(GetHNegVector(), distance)));
+    }
+
+    void SetV(float value)
+    {
+        Vector3 position = GetPosition();
+        position.y = value;
+        SetPosition(position);
+    }
+
+    void SetD(float value)
+    {
+        Vector3 position = GetPosition();
+        position.z = value;
+        SetPosition(position);
+    }
+
+    void SeteH(float value)
+    {
+        Vector3 position = GetPosition();
+        position.x = value;
+        SetPosition(position);
+    }
+
+    void RotateY(float angle)
+    {
+        auto rot = QuaternionFromEuler(0, -angle * DEG2RAD, 0);
+        SetOrientation(QuaternionMultiply(GetOrientation(), rot));
+    }
+
+    void RotateX(float angle)
+    {
+        auto rot = QuaternionFromEuler(angle * DEG2RAD, 0, 0);
+        SetOrientation(QuaternionMultiply(GetOrientation(), rot));
+    }
+
+    void RotateZ(float angle)
+    {
+        auto rot = QuaternionFromEuler(0, 0, -angle * DEG2RAD);
+        SetOrientation(QuaternionMultiply(GetOrientation(), rot));
+    }
+
+    void RotateH(float angle)
+    {
+        auto rot = QuaternionFromEuler(angle * DEG2RAD, 0, 0);
+        SetOrientation(QuaternionMultiply(rot, GetOrientation()));
+    }
+
+    void RotateV(float angle)
+    {
+        auto rot = QuaternionFromEuler(0, -angle * DEG2RAD, 0);
+        SetOrientation(QuaternionMultiply(rot, GetOrientation()));
+    }
+
+    void RotateD(float angle)
+    {
+        auto rot = QuaternionFromEuler(0, 0, -angle * DEG2RAD);
+        SetOrientation(QuaternionMultiply(rot, GetOrientation()));
+    }
+
+    void SetCamera(Camera3D& camera)
+    {
+        const Matrix& worldMatrix = GetWorldMatrix();
+        camera.position = Vector3Transform(Vector3Zero(), worldMatrix);
+        camera.target = Vector3Add(camera.position, Vector3{ worldMatrix.m8, worldMatrix.m9, worldMatrix.m10 });
+        camera.up = Vector3Subtract(Vector3Transform(Vector3{ 0,1,0 }, worldMatrix), camera.target);
+    }
+
+    void PushMatrix()
+    {
+        const Matrix& glMatrix = GetGLWorldMatrix();
+        rlPushMatrix();
+        rlMultMatrixf((float*)(&glMatrix.m0));
+    }
+
+    void PopMatrix()
+    {
+        rlPopMatrix();
+    }
+};
@@ -0,0 +1,117 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <vector>
+
+// A uniform grid on the XZ plane over the world space bounds of the map obstacles.
+// Each obstacle is listed in every cell its bounds touch, so queries only need to look at the cells they cover.
+class ObstacleGrid
+{
+public:
+    static constexpr float DefaultCellSize = 8.0f;
+    static constexpr int MaxCellsPerAxis = 512;
+
+    // the state of a ray walking through the grid one cell at a time
+    struct RayCursor
+    {
+        Vector3 Origin = { 0 };
+        Vector3 Direction = { 0 };
+        float Radius = 0;
+
+        // world distance along the ray where the current cell is entered and left
+        float Distance = 0;
+        float ExitDistance = 0;
+        float EndDistance = 0;
+
+        int CellX = 0;
+        int CellZ = 0;
+        int StepX = 0;
+        int StepZ = 0;
+
+        float NextX = 0;
+        float NextZ = 0;
+        float DeltaX = 0;
+        float DeltaZ = 0;
+
+        bool Done = true;
+    };
+
+    void Build(const std::vector<BoundingBox>& obstacleBounds, float cellSize = DefaultCellSize);
+    void Clear();
+
+    size_t GetObstacleCount() const { return Bounds.size(); }
+    float GetCellSize() const { return CellSize; }
+    int GetCellCount() const { return CountX * CountZ; }
+
+    // the obstacles listed in a cell, an obstacle can be in more than one cell
+    const int* GetCellItems(int cell, int& count) const;
+
+    // fills results with the sorted indexes of the obstacles whose bounds overlap the box
+    void QueryBounds(const BoundingBox& bounds, std::vector<int>& results) const;
+
+    // start walking a ray through the grid, a radius makes the ray a swept circle on the XZ plane
+    RayCursor StartRay(const Ray& ray, float radius = 0) const;
+
+    // fills results with the obstacles that may be hit before the cursor's ExitDistance and moves to the next cell
+    // returns false when the ray has left the grid
+    bool NextRayCells(RayCursor& cursor, std::vector<int>& results) const;
+
+    // gets the cell the cursor is in and moves to the next one, for thin rays that want to read the cells themselves
+    bool NextRayCell(RayCursor& cursor, int& cell) const;
+
+private:
+    struct CellRange
+    {
+        int MinX = 0;
+        int MinZ = 0;
+        int MaxX = 0;
+        int MaxZ = 0;
+    };
+
+    float CellSize = DefaultCellSize;
+    float MinX = 0;
+    float MinZ = 0;
+    int CountX = 0;
+    int CountZ = 0;
+
+    std::vector<BoundingBox> Bounds;
+    std::vector<CellRange> CellRanges;
+    std::vector<int> CellStarts;
+    std::vector<int> CellItems;
+
+    int GetCellX(float x) const;
+    int GetCellZ(float z) const;
+    CellRange GetCellRange(float minX, float minZ, float maxX, float maxZ) const;
+
+    void StepRay(RayCursor& cursor) const;
+    void GatherCells(int minX, int minZ, int maxX, int maxZ, std::vector<int>& results) const;
+};
@@ -0,0 +1,93 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "raylib.h"
+#include "collisions.h"
+
+#include <vector>
+
+// the walls as the player cylinder sees them, each value in its own array indexed by wall
+// the cylinder test gathers 8 walls at a time into a packet and tests them all at once, with one wall per SIMD lane
+class ObstacleStore
+{
+public:
+    static constexpr int PacketSize = 8;
+
+    struct Packet
+    {
+        // the top 3 rows of each wall's inverse world matrix, they take the cylinder into the wall's space
+        // hits are rare, so the world matrix that takes a push back out is read from the store only for walls that are hit
+        alignas(16) float Inverse[12][PacketSize];
+
+        // the wall's local bounds as a rectangle on the XZ plane, the same one IntersectBBoxCylinder builds, and its height range
+        alignas(16) float RectX[PacketSize];
+        alignas(16) float RectZ[PacketSize];
+        alignas(16) float RectWidth[PacketSize];
+        alignas(16) float RectDepth[PacketSize];
+        alignas(16) float MinY[PacketSize];
+        alignas(16) float MaxY[PacketSize];
+
+        int Index[PacketSize];
+        int Count = 0;
+    };
+
+    struct CylinderHits
+    {
+        // a bit for each lane the cylinder is pushed out the side of
+        int HitMask = 0;
+
+        // a bit for each lane the cylinder lands on top of or comes up under, these are rare and left to IntersectBBoxCylinder
+        int ScalarMask = 0;
+
+        // how far the cylinder moves to get out of each wall on its own, and the world normal of the side it is pushed out through
+        Vector3 Push[PacketSize];
+        Vector3 Normal[PacketSize];
+    };
+
+    void Build(const std::vector<Matrix>& inverseMatrices, const std::vector<Matrix>& worldMatrices, const std::vector<BoundingBox>& localBounds);
+
+    int GetCount() const { return int(RectX.size()); }
+
+    // copy up to PacketSize walls into a packet, in the order they are given
+    void GatherPacket(const int* indices, int count, Packet& packet) const;
+
+    // test a cylinder against every wall in a packet, each lane gets the same answer IntersectBBoxCylinder gives for that wall alone
+    void CollideCylinder(const Packet& packet, Vector3 position, Vector3 oldPosition, float radius, float height, CylinderHits& hits) const;
+
+private:
+    std::vector<float> Inverse[12];
+    std::vector<float> World[12];
+    std::vector<float> RectX;
+    std::vector<float> RectZ;
+    std::vector<float> RectWidth;
+    std::vector<float> RectDepth;
+    std::vector<float> MinY;
+    std::vector<float> MaxY;
+};
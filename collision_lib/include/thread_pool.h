@@ -1,4 +1,3 @@
-
 /*********************************************************************************************
 *
 *   raylib-extras, FPS collision example
@@ -29,69 +28,48 @@
 
 #pragma once
 
-#include "object_transform.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <vector>
-#include <deque>
-
-class Obstacle
-{
-public:
-    ObjectTransform Transform;
-    Vector3 Scale = { 1, 1, 1 };
-    Color Tint = DARKGREEN;
-
-    Vector3 thing{ 1,2,2 };
-
-    Vector3 LastNearestPoint = { 0,0 };
-
-    BoundingBox Bounds = { 0 };
-
-    Obstacle() = default;
-    Obstacle(float x, float z, float width, float height, float depth, float angle);
-    bool CollideWithPlayer(Vector3& newPosition, Vector3 oldPosition, float radius, float height);
-
-    bool CheckRaycast(Ray worldRay, RayCollision& collision);
-};
-
-struct Explosion
-{
-    Vector3 Postion = { 0 };
-    Vector3 Normal = { 0 };
-    float Lifetime = 0;
-
-    static constexpr float MaxLife = 0.25f;
-};
 
-class Map
+// a small pool of worker threads that splits a job into numbered tasks
+// the thread that starts a job helps run it, and the call returns when every task is done
+// the raycaster links this library for it too, so there is one copy
+class ThreadPool
 {
 public:
-    std::vector<Obstacle> Walls;
-    std::deque<Explosion> Explosions;
+    // a worker count of 0 uses one worker for each core, minus the calling thread
+    ThreadPool(size_t workerCount = 0);
+    ~ThreadPool();
 
-    static void SetupGraphics();
-    static void CleanupGraphics();
-    static Shader GetLightShader();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator = (const ThreadPool&) = delete;
 
-    void Setup();
-    void Cleanup();
+    // how many threads run tasks, including the calling thread
+    size_t GetThreadCount() const { return Workers.size() + 1; }
 
-    bool CollidePlayer(Vector3& newPosition, Vector3 oldPosition, float radius, float height);
-    bool CollideRay(Ray worldspaceRay, RayCollision& outputCollision, Obstacle* hitObstacle = nullptr);
+    // run task(index) for every index from 0 to count-1, spread over all the threads
+    void Run(size_t taskCount, const std::function<void(size_t)>& task);
 
-    void Draw(Camera3D& view);
-    void DrawWalls(Camera3D& view);
+private:
+    void WorkerLoop();
+    void RunTasks();
 
-    void AddExplosition(RayCollision& collision);
+    std::vector<std::thread> Workers;
 
-    void AddShotSound();
+    std::mutex Lock;
+    std::condition_variable WakeWorkers;
+    std::condition_variable WorkersDone;
 
-private:
-    static constexpr int MaxSounds = 32;
+    const std::function<void(size_t)>* Task = nullptr;
+    size_t TaskCount = 0;
+    std::atomic<size_t> NextTask = { 0 };
 
-    Sound ShotSound = { 0 };
-    Sound ShotLoop[MaxSounds] = { 0 };
-    int CurrentShotSound = 0;
+    size_t JobId = 0;
+    size_t BusyWorkers = 0;
+    bool Quit = false;
 };
-
-
-void BuildDemoMap(Map& map);
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <cstdint>
+#include <vector>
+
+// the matrix that takes a node's local space into its parent's space
+inline Matrix TransformLocalMatrix(const Vector3& position, const Quaternion& orientation)
+{
+    // the inverse of a rotation is its transpose, and the translation goes straight into the last row
+    Matrix local = MatrixTranspose(QuaternionToMatrix(orientation));
+    local.m12 = position.x;
+    local.m13 = position.y;
+    local.m14 = position.z;
+
+    return local;
+}
+
+// a transform hierarchy kept in flat arrays, sorted so every parent comes before its children
+// one pass down the arrays updates the world matrix of every node that moved, or that has a parent that moved
+// nodes are found by id, ids don't change when the arrays are sorted again after a reparent
+// nodes are never removed, clear the graph to start over
+class TransformGraph
+{
+public:
+    static constexpr int NoParent = -1;
+
+    // add a node at the origin under a parent node, returns its id
+    // the version counts up from the one given, so a transform moving into the graph doesn't go back to an old version
+    int AddNode(int parent = NoParent, unsigned int version = 0);
+
+    // move a node under another one, or under nothing, a parent that is the node or below it is ignored
+    bool SetParent(int node, int parent);
+    int GetParent(int node) const;
+
+    int GetCount() const { return int(Slots.size()); }
+
+    void Clear();
+
+    const Vector3& GetPosition(int node) const { return Positions[Slots[node]]; }
+    const Quaternion& GetOrientation(int node) const { return Orientations[Slots[node]]; }
+
+    void SetPosition(int node, const Vector3& position)
+    {
+        Positions[Slots[node]] = position;
+        SetChanged(node);
+    }
+
+    void SetOrientation(int node, const Quaternion& orientation)
+    {
+        Orientations[Slots[node]] = orientation;
+        SetChanged(node);
+    }
+
+    // flag a node as moved, so it and everything under it is updated
+    void SetChanged(int node)
+    {
+        Changed[Slots[node]] = 1;
+        Dirty = true;
+    }
+
+    // true when any node has moved since the world matrices were last updated
+    bool IsDirty() const { return Dirty; }
+
+    // true when a node or one above it has moved since the world matrices were last updated
+    bool IsChanged(int node) const
+    {
+        if (!Dirty)
+            return false;
+
+        for (int slot = Slots[node]; slot != NoParent; slot = Parents[slot])
+        {
+            if (Changed[slot])
+                return true;
+        }
+
+        return false;
+    }
+
+    // goes up each time the update gives a node a new world matrix, keep it to tell when one node has moved
+    unsigned int GetVersion(int node)
+    {
+        if (Dirty)
+            UpdateWorldMatrices();
+
+        return Versions[Slots[node]];
+    }
+
+    // the world matrix of a node, the whole graph is updated first when anything has moved
+    const Matrix& GetWorldMatrix(int node)
+    {
+        if (Dirty)
+            UpdateWorldMatrices();
+
+        return WorldMatrices[Slots[node]];
+    }
+
+    // update the world matrix of every node that moved and everything under it, in one pass
+    void UpdateWorldMatrices();
+
+private:
+    // each value in its own array, indexed by slot, parents are slots too
+    std::vector<int> Parents;
+    std::vector<Vector3> Positions;
+    std::vector<Quaternion> Orientations;
+    std::vector<Matrix> WorldMatrices;
+    std::vector<uint8_t> Changed;
+    std::vector<unsigned int> Versions;
+
+    // the slot each node id is in and the node id in each slot
+    std::vector<int> Slots;
+    std::vector<int> Nodes;
+
+    bool Dirty = false;
+    bool Sorted = true;
+
+    // put the slots back in parent first order after a reparent broke it
+    void Sort();
+};
@@ -0,0 +1,64 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#pragma once
+
+#include "raylib.h"
+#include "collisions.h"
+#include "obstacle_grid.h"
+
+#include <vector>
+
+// a copy of the walls in grid cell order, packed 4 to a packet with one wall per SIMD lane
+// a ray walking the grid can slab test every wall in a cell without gathering them from all over memory
+class WallPackets
+{
+public:
+    static constexpr int PacketSize = 4;
+
+    struct Packet
+    {
+        // the top 3 rows of each wall's inverse world matrix, they take a world point into the wall's local space
+        alignas(16) float Inverse[12][PacketSize];
+        alignas(16) float Min[3][PacketSize];
+        alignas(16) float Max[3][PacketSize];
+        int Index[PacketSize];
+    };
+
+    void Build(const ObstacleGrid& grid, const std::vector<Matrix>& inverseMatrices, const std::vector<BoundingBox>& localBounds);
+
+    // find the nearest wall a ray hits, returns the wall index or -1
+    // the distance is in lengths of the ray direction, the same way GetRayCollisionBox reports it
+    int CastRay(const ObstacleGrid& grid, const Ray& ray, float& distance) const;
+
+private:
+    std::vector<Packet> Packets;
+    std::vector<int> CellStarts;
+
+    void TestPacket(const Packet& packet, const Vector3& origin, const Vector3& direction, float& nearest, int& nearestIndex) const;
+};
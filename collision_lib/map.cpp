@@ -0,0 +1,778 @@
+
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include "map.h"
+#include "collisions.h"
+
+#define RLIGHTS_IMPLEMENTATION
+#include "rlights.h"
+
+#include <algorithm>
+
+// rotate a direction by a matrix without the translation
+// this is exact where transforming two points and subtracting them loses precision far from the origin
+static Vector3 RotateByMatrix(Vector3 direction, const Matrix& matrix)
+{
+    return Vector3{ matrix.m0 * direction.x + matrix.m4 * direction.y + matrix.m8 * direction.z,
+                    matrix.m1 * direction.x + matrix.m5 * direction.y + matrix.m9 * direction.z,
+                    matrix.m2 * direction.x + matrix.m6 * direction.y + matrix.m10 * direction.z };
+}
+
+// true when the inner box is all inside the outer one
+static bool ContainsBox(const BoundingBox& outer, const BoundingBox& inner)
+{
+    return inner.min.x >= outer.min.x && inner.min.y >= outer.min.y && inner.min.z >= outer.min.z &&
+        inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+}
+
+// obstacle
+Obstacle::Obstacle(float x, float z, float width, float height, float depth, float angle)
+{
+    Transform.SetPosition(x, height * 0.5f, z);
+    Transform.RotateV(angle);
+    Scale.x = width;
+    Scale.y = height;
+    Scale.z = depth;
+
+    Bounds.min = Vector3{ width * -0.5f, height * -0.5f, depth * -0.5f };
+    Bounds.max = Vector3{ width * 0.5f, height * 0.5f, depth * 0.5f };
+
+    UpdateTransformCache();
+}
+
+void Obstacle::UpdateTransformCache()
+{
+    WorldMatrix = Transform.GetWorldMatrix();
+    TransformVersion = Transform.GetWorldVersion();
+    InverseWorldMatrix = MatrixInvert(WorldMatrix);
+    WorldBox = OrientedBoxFromBounds(Bounds, WorldMatrix);
+}
+
+void Obstacle::CheckTransformCache()
+{
+    // the version catches moves even when something else has already read the new world matrix
+    if (Transform.GetWorldVersion() != TransformVersion)
+        UpdateTransformCache();
+}
+
+const OrientedBox& Obstacle::GetWorldBox()
+{
+    CheckTransformCache();
+    return WorldBox;
+}
+
+const Matrix& Obstacle::GetWorldMatrix()
+{
+    CheckTransformCache();
+    return WorldMatrix;
+}
+
+const Matrix& Obstacle::GetInverseWorldMatrix()
+{
+    CheckTransformCache();
+    return InverseWorldMatrix;
+}
+
+BoundingBox Obstacle::GetWorldBounds()
+{
+    return GetOrientedBoxBounds(GetWorldBox());
+}
+
+bool Obstacle::CollideWithPlayer(Vector3& newPosition, Vector3 oldPosition, float radius, float height)
+{
+    CheckTransformCache();
+
+    // transform the input into the rotated space of the obstacle
+    Vector3 localPos = Vector3Transform(newPosition, InverseWorldMatrix);
+    Vector3 locaOldPos = Vector3Transform(oldPosition, InverseWorldMatrix);
+
+    Vector3 hitNormal = { 0 };
+
+    // see if the player cylinder (in local space) hits our bounding box, and clamp the position to be outside of it
+    bool hit = IntersectBBoxCylinder(Bounds, localPos, locaOldPos, radius, height, LastNearestPoint, hitNormal);
+
+    // transform the local position back into worldspace, a miss leaves it alone so it doesn't pick up rounding errors
+    if (hit)
+        newPosition = Vector3Transform(localPos, WorldMatrix);
+
+    return hit;
+}
+
+bool Obstacle::SweepPlayer(Vector3 position, Vector3 movement, float radius, float height, float& hitTime, Vector3& hitNormal)
+{
+    CheckTransformCache();
+
+    // sweep in the rotated space of the obstacle, then turn the normal back into world space
+    Vector3 localPos = Vector3Transform(position, InverseWorldMatrix);
+    Vector3 localMovement = RotateByMatrix(movement, InverseWorldMatrix);
+
+    Vector3 localNormal = { 0 };
+    if (!SweepCylinderBBox(Bounds, localPos, localMovement, radius, height, hitTime, localNormal))
+        return false;
+
+    hitNormal = RotateByMatrix(localNormal, WorldMatrix);
+    return true;
+}
+
+bool Obstacle::CheckRaycast(Ray worldRay, RayCollision & collision, float radius)
+{
+    CheckTransformCache();
+    return CheckRaycastCached(worldRay, collision, radius);
+}
+
+bool Obstacle::CheckRaycastCached(Ray worldRay, RayCollision& collision, float radius) const
+{
+    // transform the ray into local space
+    Ray localRay = { 0 };
+    localRay.position = Vector3Transform(worldRay.position, InverseWorldMatrix);
+    localRay.direction = RotateByMatrix(worldRay.direction, InverseWorldMatrix);
+
+    // see if the local space ray hits our bounding box
+    collision = GetRayCollisionBox(localRay, Bounds + radius);
+
+    // transform the hit point and normal back into world space
+    if (collision.hit)
+    {
+        collision.point = Vector3Transform(collision.point, WorldMatrix);
+        collision.distance = Vector3Distance(worldRay.position, collision.point);
+        collision.normal = Vector3Add(Vector3Add(Vector3Scale(WorldBox.Axes[0], collision.normal.x), Vector3Scale(WorldBox.Axes[1], collision.normal.y)), Vector3Scale(WorldBox.Axes[2], collision.normal.z));
+    }
+
+    return collision.hit;
+}
+
+bool Obstacle::SphereCast(Ray worldRay, float radius, float maxDistance, float& distance, Vector3& hitNormal)
+{
+    CheckTransformCache();
+
+    // walls are only moved and turned, so distances along the ray are the same in local space
+    Ray localRay = { 0 };
+    localRay.position = Vector3Transform(worldRay.position, InverseWorldMatrix);
+    localRay.direction = RotateByMatrix(worldRay.direction, InverseWorldMatrix);
+
+    Vector3 localNormal = { 0 };
+    if (!SphereCastBBox(Bounds, localRay, radius, maxDistance, distance, localNormal))
+        return false;
+
+    hitNormal = RotateByMatrix(localNormal, WorldMatrix);
+    return true;
+}
+
+// map graphics
+static Mesh WallMesh = { 0 };
+static Mesh PlaneMesh = { 0 };
+
+static Material WallMaterial = { 0 };
+static Material WallInstanceMaterial = { 0 };
+static Material PlaneMaterial = { 0 };
+
+static Texture2D ExplosionTexture = { 0 };
+
+void BuildDemoMap(Map& map)
+{  
+    map.Walls.emplace_back(10.0f, 10.0f, 3.5f, 3.0f, 14.0f, 0.0f);
+    map.Walls.emplace_back(20.0f, 10.0f, 0.5f, 3.0f, 15.0f, 90.0f);
+    map.Walls.emplace_back(-20.0f, 10.0f, 0.5f, 3.0f, 15.0f, 45.0f);
+    map.Walls.emplace_back(-20.0f, 10.0f, 0.5f, 3.0f, 15.0f, -45.0f);
+
+    map.Walls.emplace_back(20.0f, -10.0f, 2.5f, 3.0f, 25.0f, 30.0f);
+
+    map.Walls.emplace_back(0.0f, -20.0f, 1.5f, 3.0f, 35.0f, 90.0f);
+
+    map.WallsChanged();
+}
+
+void BuildDemoLevel(Map& map)
+{
+    // a giant blaster lying on its side, as an example of level geometry that isn't made of boxes
+    Matrix transform = MatrixMultiply(MatrixScale(40, 40, 40), MatrixRotateY(90 * DEG2RAD));
+    transform = MatrixMultiply(transform, MatrixTranslate(0, 4.8f, 32));
+
+    map.LoadLevelModel("resources/blasterH.glb", transform);
+}
+
+
+// map
+void Map::SetupGraphics()
+{
+    CleanupGraphics();
+
+    WallMesh = GenMeshCube(1, 1, 1);
+    WallMaterial = LoadMaterialDefault();
+    WallMaterial.shader = LoadShader("resources/shaders/lighting.vs", "resources/shaders/lighting.fs");
+    WallMaterial.shader.locs[SHADER_LOC_VECTOR_VIEW] = GetShaderLocation(WallMaterial.shader, "viewPos");
+
+    CreateLight(LIGHT_POINT, Vector3{ -200, 100, -200 }, Vector3Zero(), WHITE, WallMaterial.shader);
+
+    // Ambient light level (some basic lighting)
+    int ambientLoc = GetShaderLocation(WallMaterial.shader, "ambient");
+    float ambient[4] = { 0.1f, 0.1f, 0.1f, 1.0f };
+    SetShaderValue(WallMaterial.shader, ambientLoc, ambient, SHADER_UNIFORM_VEC4);
+
+    WallMaterial.maps[MATERIAL_MAP_ALBEDO].texture = LoadTexture("resources/texture_12.png");
+
+    // walls are all drawn in one instanced draw, with the same lighting and texture
+    WallInstanceMaterial = LoadMaterialDefault();
+    WallInstanceMaterial.shader = LoadShader("resources/shaders/lighting_instancing.vs", "resources/shaders/lighting.fs");
+    WallInstanceMaterial.shader.locs[SHADER_LOC_MATRIX_MVP] = GetShaderLocation(WallInstanceMaterial.shader, "mvp");
+    WallInstanceMaterial.shader.locs[SHADER_LOC_VECTOR_VIEW] = GetShaderLocation(WallInstanceMaterial.shader, "viewPos");
+    WallInstanceMaterial.shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(WallInstanceMaterial.shader, "instanceTransform");
+
+    CreateLight(LIGHT_POINT, Vector3{ -200, 100, -200 }, Vector3Zero(), WHITE, WallInstanceMaterial.shader);
+    SetShaderValue(WallInstanceMaterial.shader, GetShaderLocation(WallInstanceMaterial.shader, "ambient"), ambient, SHADER_UNIFORM_VEC4);
+
+    WallInstanceMaterial.maps[MATERIAL_MAP_ALBEDO].texture = WallMaterial.maps[MATERIAL_MAP_ALBEDO].texture;
+
+    PlaneMesh = GenMeshPlane(100, 100, 50, 50);
+    PlaneMaterial = LoadMaterialDefault();
+    PlaneMaterial.shader = WallMaterial.shader;
+    PlaneMaterial.maps[MATERIAL_MAP_ALBEDO].texture = LoadTexture("resources/texture_07.png");
+
+    // a soft round spot for the explosion quads
+    Image explosionImage = GenImageGradientRadial(64, 64, 0.0f, WHITE, BLANK);
+    ExplosionTexture = LoadTextureFromImage(explosionImage);
+    UnloadImage(explosionImage);
+}
+
+void Map::CleanupGraphics()
+{
+    if (!IsShaderValid(WallMaterial.shader))
+        return;
+
+    UnloadShader(WallMaterial.shader);
+    WallMaterial.shader.id = 0;
+
+    // the instanced material shares the wall texture, so only the shader is its own
+    UnloadShader(WallInstanceMaterial.shader);
+    WallInstanceMaterial.shader.id = 0;
+    WallInstanceMaterial.maps[MATERIAL_MAP_ALBEDO].texture.id = 0;
+
+    UnloadTexture(WallMaterial.maps[MATERIAL_MAP_ALBEDO].texture);
+    WallMaterial.maps[MATERIAL_MAP_ALBEDO].texture.id = 0;
+
+    UnloadTexture(PlaneMaterial.maps[MATERIAL_MAP_ALBEDO].texture);
+    PlaneMaterial.maps[MATERIAL_MAP_ALBEDO].texture.id = 0;
+
+    UnloadMesh(WallMesh);
+    WallMesh.vertexCount = 0;
+
+    UnloadTexture(ExplosionTexture);
+    ExplosionTexture.id = 0;
+}
+
+Shader Map::GetLightShader()
+{
+    return WallMaterial.shader;
+}
+
+void Map::Setup()
+{
+    ShotSound = LoadSound("resources/laserLarge_004.ogg");
+    for (int i = 0; i < MaxSounds; i++)
+        ShotLoop[i] = LoadSoundAlias(ShotSound);
+}
+
+void Map::Cleanup()
+{
+    for (int i = 0; i < MaxSounds; i++)
+        UnloadSoundAlias(ShotLoop[i]);
+
+    UnloadSound(ShotSound);
+
+    for (Model& model : LevelModels)
+        UnloadModel(model);
+    LevelModels.clear();
+}
+
+bool Map::LoadLevelModel(const char* fileName, Matrix transform)
+{
+    Model model = LoadModel(fileName);
+    if (!IsModelValid(model))
+        return false;
+
+    model.transform = transform;
+    for (int i = 0; i < model.materialCount; i++)
+        model.materials[i].shader = GetLightShader();
+
+    // the vertex data stays on the CPU after loading, so the triangles can be copied out for collisions
+    LevelMesh.AddModel(model);
+    LevelMesh.Build();
+
+    LevelModels.push_back(model);
+    return true;
+}
+
+void Map::WallsChanged()
+{
+    WallGridDirty = true;
+    WallTransformsDirty = true;
+}
+
+void Map::UpdateWallTransforms()
+{
+    if (!WallTransformsDirty && WallTransforms.size() == Walls.size())
+        return;
+
+    // the cube mesh is unit sized, so each wall is scaled before its own transform is applied
+    WallTransforms.resize(Walls.size());
+    for (size_t i = 0; i < Walls.size(); i++)
+    {
+        Obstacle& wall = Walls[i];
+        WallTransforms[i] = MatrixMultiply(MatrixScale(wall.Scale.x, wall.Scale.y, wall.Scale.z), wall.Transform.GetWorldMatrix());
+    }
+
+    WallTransformsDirty = false;
+}
+
+void Map::UpdateWallGrid()
+{
+    if (!WallGridDirty && WallGrid.GetObstacleCount() == Walls.size())
+        return;
+
+    std::vector<BoundingBox> wallBounds;
+    std::vector<BoundingBox> localBounds;
+    std::vector<Matrix> inverseMatrices;
+    std::vector<Matrix> worldMatrices;
+    wallBounds.reserve(Walls.size());
+    localBounds.reserve(Walls.size());
+    inverseMatrices.reserve(Walls.size());
+    worldMatrices.reserve(Walls.size());
+
+    for (auto& wall : Walls)
+    {
+        wall.UpdateTransformCache();
+        wallBounds.push_back(wall.GetWorldBounds());
+        localBounds.push_back(wall.Bounds);
+        inverseMatrices.push_back(wall.GetInverseWorldMatrix());
+        worldMatrices.push_back(wall.GetWorldMatrix());
+    }
+
+    WallGrid.Build(wallBounds);
+    WallRayPackets.Build(WallGrid, inverseMatrices, localBounds);
+    WallStore.Build(inverseMatrices, worldMatrices, localBounds);
+    WallGridDirty = false;
+}
+
+void Map::UpdateWallCaches()
+{
+    // walls in a graph update the whole graph on the first read after anything in it moved, so that happens here and not on a worker
+    for (Obstacle& wall : Walls)
+        wall.GetWorldMatrix();
+}
+
+bool Map::CollidePlayer(Vector3& newPosition, Vector3 oldPosition, float radius, float height)
+{
+    UpdateWallGrid();
+
+    // only test the walls near the move, padded so a push off a wall's side usually stays inside the walls that were gathered
+    float reach = radius * 2;
+    BoundingBox moveBounds = { Vector3Min(newPosition, oldPosition), Vector3Max(newPosition, oldPosition) };
+    BoundingBox queryBounds = { Vector3Subtract(moveBounds.min, Vector3{ reach, 0, reach }), Vector3Add(moveBounds.max, Vector3{ reach, height, reach }) };
+
+    WallGrid.QueryBounds(queryBounds, WallCandidates);
+
+    // test the nearby walls a packet at a time, in wall order
+    bool hitSomething = false;
+    ObstacleStore::Packet packet;
+    size_t first = 0;
+    while (first < WallCandidates.size())
+    {
+        int count = int(std::min(WallCandidates.size() - first, size_t(ObstacleStore::PacketSize)));
+        WallStore.GatherPacket(WallCandidates.data() + first, count, packet);
+        first += count;
+
+        // each push moves the player before the next wall is tested, so after a hit the rest of the packet is tested again
+        int lane = 0;
+        while (lane < count)
+        {
+            ObstacleStore::CylinderHits hits;
+            WallStore.CollideCylinder(packet, newPosition, oldPosition, radius, height, hits);
+
+            int remaining = (hits.HitMask | hits.ScalarMask) & ~((1 << lane) - 1);
+            if (remaining == 0)
+                break;
+
+            while (!(remaining & (1 << lane)))
+                lane++;
+
+            int wall = packet.Index[lane];
+            if (hits.ScalarMask & (1 << lane))
+                Walls[wall].CollideWithPlayer(newPosition, oldPosition, radius, height);
+            else
+                newPosition = Vector3Add(newPosition, hits.Push[lane]);
+
+            hitSomething = true;
+            lane++;
+
+            // each push can move the player up to a radius, so a few in a row can carry it past the gathered walls
+            // every wall before this one was tested while the player was still inside the query, so only later walls can have been missed
+            BoundingBox playerBounds = { Vector3Subtract(newPosition, Vector3{ radius, 0, radius }), Vector3Add(newPosition, Vector3{ radius, height, radius }) };
+            if (ContainsBox(queryBounds, playerBounds))
+                continue;
+
+            queryBounds.min = Vector3Min(queryBounds.min, Vector3Subtract(playerBounds.min, Vector3{ radius, 0, radius }));
+            queryBounds.max = Vector3Max(queryBounds.max, Vector3Add(playerBounds.max, Vector3{ radius, 0, radius }));
+
+            WallGrid.QueryBounds(queryBounds, WallCandidates);
+            WallCandidates.erase(WallCandidates.begin(), std::upper_bound(WallCandidates.begin(), WallCandidates.end(), wall));
+            first = 0;
+            break;
+        }
+    }
+
+    if (LevelMesh.CollideCylinder(newPosition, radius, height))
+        hitSomething = true;
+
+    return hitSomething;
+}
+
+bool Map::MovePlayer(Vector3& newPosition, Vector3 oldPosition, float radius, float height)
+{
+    UpdateWallGrid();
+
+    Vector3 position = oldPosition;
+    Vector3 movement = Vector3Subtract(newPosition, oldPosition);
+    bool hitSomething = false;
+
+    for (int slide = 0; slide < MaxSlides && Vector3LengthSqr(movement) > 0; slide++)
+    {
+        Vector3 segmentStart = position;
+
+        // only the walls near the swept cylinder can be hit
+        BoundingBox sweepBounds = { Vector3Min(position, Vector3Add(position, movement)), Vector3Max(position, Vector3Add(position, movement)) };
+        sweepBounds.min = Vector3Subtract(sweepBounds.min, Vector3{ radius, 0, radius });
+        sweepBounds.max = Vector3Add(sweepBounds.max, Vector3{ radius, height, radius });
+
+        WallGrid.QueryBounds(sweepBounds, WallCandidates);
+
+        float hitTime = 1;
+        Vector3 hitNormal = { 0 };
+        bool hit = false;
+
+        for (int index : WallCandidates)
+        {
+            float wallTime = 0;
+            Vector3 wallNormal = { 0 };
+            if (Walls[index].SweepPlayer(position, movement, radius, height, wallTime, wallNormal) && wallTime < hitTime)
+            {
+                hitTime = wallTime;
+                hitNormal = wallNormal;
+                hit = true;
+            }
+        }
+
+        if (hit)
+        {
+            hitSomething = true;
+
+            // move up to the wall, then back off a hair so the next sweep doesn't start touching it
+            position = Vector3Add(position, Vector3Scale(movement, hitTime));
+            position = Vector3Add(position, Vector3Scale(hitNormal, SlideSkin));
+        }
+        else
+        {
+            position = Vector3Add(position, movement);
+        }
+
+        // the level mesh is walked in small steps along each piece of the slide, so it can't be skipped through either
+        if (LevelMesh.MoveCylinder(position, segmentStart, radius, height))
+            hitSomething = true;
+
+        if (!hit)
+            break;
+
+        // slide along the wall with whatever movement is left
+        movement = Vector3Scale(movement, 1 - hitTime);
+        float intoWall = Vector3DotProduct(movement, hitNormal);
+        if (intoWall < 0)
+            movement = Vector3Subtract(movement, Vector3Scale(hitNormal, intoWall));
+    }
+
+    // anything the sweep can't fix, like starting inside a wall, gets pushed out the same way as before
+    if (CollidePlayer(position, oldPosition, radius, height))
+        hitSomething = true;
+
+    newPosition = position;
+    return hitSomething;
+}
+
+bool Map::CollideRay(Ray worldspaceRay, RayCollision& outputCollision, Obstacle** hitObstacle, float radius)
+{
+    RayCollision collision = { 0 };
+    Obstacle* hitWall = nullptr;
+
+    outputCollision.hit = false;
+    outputCollision.distance = std::numeric_limits<float>::max();
+
+    UpdateWallGrid();
+
+    // walk the grid cells along the ray, nearest first
+    // the radius grows each wall in its own rotated space, so it can reach up to sqrt(2) times further along the world axes
+    ObstacleGrid::RayCursor cursor = WallGrid.StartRay(worldspaceRay, radius * sqrtf(2.0f));
+    while (WallGrid.NextRayCells(cursor, WallCandidates))
+    {
+        for (int index : WallCandidates)
+        {
+            auto& wall = Walls[index];
+            if (wall.CheckRaycast(worldspaceRay, collision, radius))
+            {
+                if (collision.distance < outputCollision.distance)
+                {
+                    outputCollision = collision;
+                    hitWall = &wall;
+                }
+            }
+        }
+
+        // nothing in a later cell can be closer than a hit before the ray left this one
+        if (outputCollision.hit && Vector3Distance(worldspaceRay.position, outputCollision.point) <= cursor.ExitDistance)
+            break;
+    }
+
+    float wallDistance = outputCollision.distance;
+
+    CollideLevelMesh(worldspaceRay, outputCollision);
+    CollideFloor(worldspaceRay, outputCollision, radius);
+
+    // the level mesh or floor replaced the wall hit if they were closer
+    if (hitObstacle != nullptr)
+        *hitObstacle = (hitWall != nullptr && outputCollision.distance == wallDistance) ? hitWall : nullptr;
+
+    return outputCollision.hit;
+}
+
+bool Map::SphereCast(Ray worldspaceRay, float radius, float maxDistance, RayCollision& outputCollision)
+{
+    UpdateWallGrid();
+
+    outputCollision = RayCollision{ 0 };
+    outputCollision.distance = maxDistance;
+
+    // only the walls that overlap the bounds of the whole cast can be touched
+    Vector3 end = Vector3Add(worldspaceRay.position, Vector3Scale(worldspaceRay.direction, maxDistance));
+    BoundingBox castBounds = BoundingBox{ Vector3Min(worldspaceRay.position, end), Vector3Max(worldspaceRay.position, end) } + radius;
+
+    WallGrid.QueryBounds(castBounds, WallCandidates);
+
+    for (int index : WallCandidates)
+    {
+        float distance = 0;
+        Vector3 normal = { 0 };
+        if (Walls[index].SphereCast(worldspaceRay, radius, outputCollision.distance, distance, normal) && distance < outputCollision.distance)
+        {
+            outputCollision.hit = true;
+            outputCollision.distance = distance;
+            outputCollision.normal = normal;
+        }
+    }
+
+    // the floor is grown by the radius, so the ray hits it where the sphere would
+    RayCollision floorHit = { 0 };
+    CollideFloor(worldspaceRay, floorHit, radius);
+    if (floorHit.hit && floorHit.distance < outputCollision.distance)
+        outputCollision = floorHit;
+
+    RayCollision meshHit = { 0 };
+    if (LevelMesh.CollideRay(worldspaceRay, meshHit, outputCollision.distance + radius))
+    {
+        float distance = std::max(meshHit.distance - radius, 0.0f);
+        if (distance < outputCollision.distance)
+        {
+            outputCollision.hit = true;
+            outputCollision.distance = distance;
+            outputCollision.normal = meshHit.normal;
+        }
+    }
+
+    outputCollision.point = Vector3Add(worldspaceRay.position, Vector3Scale(worldspaceRay.direction, outputCollision.distance));
+    return outputCollision.hit;
+}
+
+void Map::CollideLevelMesh(Ray worldspaceRay, RayCollision& collision) const
+{
+    // the level mesh only needs checking up to the wall that was hit
+    float maxDistance = std::numeric_limits<float>::max();
+    if (collision.hit)
+        maxDistance = Vector3Distance(worldspaceRay.position, collision.point);
+
+    RayCollision meshCollision = { 0 };
+    if (LevelMesh.CollideRay(worldspaceRay, meshCollision, maxDistance))
+        collision = meshCollision;
+}
+
+void Map::CollideFloor(Ray worldspaceRay, RayCollision& outputCollision, float radius) const
+{
+    if (!FloorCollisions)
+        return;
+
+    RayCollision floorHit = GetRayCollisionBox(worldspaceRay, BoundingBox{ Vector3{-1000,-1,-1000}, Vector3{1000, radius,1000} });
+    if (floorHit.hit && !outputCollision.hit)
+    {
+        outputCollision = floorHit;
+    }
+    else if (floorHit.hit && outputCollision.hit && floorHit.distance < outputCollision.distance)
+    {
+        outputCollision = floorHit;
+    }
+}
+
+int Map::CollideWallsCached(Ray worldspaceRay, RayCollision& outputCollision, float radius, std::vector<int>& candidates) const
+{
+    RayCollision collision = { 0 };
+    int hitWall = -1;
+
+    // the same grid walk as CollideRay, without touching the walls' caches
+    ObstacleGrid::RayCursor cursor = WallGrid.StartRay(worldspaceRay, radius * sqrtf(2.0f));
+    while (WallGrid.NextRayCells(cursor, candidates))
+    {
+        for (int index : candidates)
+        {
+            if (Walls[index].CheckRaycastCached(worldspaceRay, collision, radius) && collision.distance < outputCollision.distance)
+            {
+                outputCollision = collision;
+                hitWall = index;
+            }
+        }
+
+        if (outputCollision.hit && Vector3Distance(worldspaceRay.position, outputCollision.point) <= cursor.ExitDistance)
+            break;
+    }
+
+    return hitWall;
+}
+
+void Map::CollideRays(const Ray* worldspaceRays, RayCollision* outputCollisions, size_t count, float radius)
+{
+    UpdateWallGrid();
+    UpdateWallCaches();
+
+    // the workers only read the walls, through the caches that were just brought up to date
+    const std::vector<Obstacle>& walls = Walls;
+
+    auto castRays = [&](size_t start, size_t end)
+    {
+        std::vector<int> candidates;
+
+        for (size_t i = start; i < end; i++)
+        {
+            RayCollision& collision = outputCollisions[i];
+            collision = RayCollision{ 0 };
+            collision.distance = std::numeric_limits<float>::max();
+
+            if (radius > 0)
+            {
+                CollideWallsCached(worldspaceRays[i], collision, radius, candidates);
+            }
+            else
+            {
+                // the packets find the wall, then the wall fills out the point and normal the same way a single ray does
+                float distance = 0;
+                int wall = WallRayPackets.CastRay(WallGrid, worldspaceRays[i], distance);
+                if (wall >= 0)
+                    walls[wall].CheckRaycastCached(worldspaceRays[i], collision);
+            }
+
+            CollideLevelMesh(worldspaceRays[i], collision);
+            CollideFloor(worldspaceRays[i], collision, radius);
+        }
+    };
+
+    if (count < ThreadedRayBatch)
+    {
+        castRays(0, count);
+        return;
+    }
+
+    if (!RayWorkers)
+        RayWorkers = std::make_unique<ThreadPool>();
+
+    size_t taskCount = (count + RaysPerTask - 1) / RaysPerTask;
+    RayWorkers->Run(taskCount, [&](size_t task)
+        {
+            castRays(task * RaysPerTask, std::min(count, (task + 1) * RaysPerTask));
+        });
+}
+
+void Map::Update(float deltaTime)
+{
+    Explosions.Update(deltaTime);
+}
+
+void Map::Draw(Camera3D &view)
+{
+    if (!IsTextureValid(PlaneMaterial.maps[MATERIAL_MAP_ALBEDO].texture))
+        return;
+
+    float cameraPos[3] = { view.position.x, view.position.y, view.position.z };
+    SetShaderValue(WallMaterial.shader, WallMaterial.shader.locs[SHADER_LOC_VECTOR_VIEW], cameraPos, SHADER_UNIFORM_VEC3);
+
+    DrawMesh(PlaneMesh, PlaneMaterial, MatrixIdentity());
+
+    DrawWalls(view);
+
+    for (const Model& model : LevelModels)
+        DrawModel(model, Vector3Zero(), 1, WHITE);
+
+    // axis markers
+    DrawCube(Vector3{ 1,0,0 }, 1.25f, 0.25f, 0.25f, RED);
+    DrawCube(Vector3{ 0,0,1 }, 0.25f, 0.25f, 1.25f, BLUE);
+
+    // explosions
+    rlDisableDepthMask();
+    Explosions.Draw(view, ExplosionTexture);
+    rlDrawRenderBatchActive();
+    rlEnableDepthMask();
+}
+
+void Map::DrawWalls(Camera3D& view)
+{
+    if (!IsTextureValid(WallInstanceMaterial.maps[MATERIAL_MAP_ALBEDO].texture) || Walls.empty())
+        return;
+
+    UpdateWallTransforms();
+
+    float cameraPos[3] = { view.position.x, view.position.y, view.position.z };
+    SetShaderValue(WallInstanceMaterial.shader, WallInstanceMaterial.shader.locs[SHADER_LOC_VECTOR_VIEW], cameraPos, SHADER_UNIFORM_VEC3);
+
+    // one draw call for every wall, the minimap draws from the same transforms
+    DrawMeshInstanced(WallMesh, WallInstanceMaterial, WallTransforms.data(), int(WallTransforms.size()));
+}
+
+void Map::AddExplosition(RayCollision& collision)
+{
+    Explosions.Add(collision.point, collision.normal);
+}
+
+void Map::AddShotSound()
+{
+    CurrentShotSound++;
+    if (CurrentShotSound >= MaxSounds)
+        CurrentShotSound = 0;
+    PlaySound(ShotLoop[CurrentShotSound]);
+}
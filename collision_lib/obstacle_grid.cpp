@@ -0,0 +1,304 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include "obstacle_grid.h"
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// obstacles are registered slightly larger than their bounds so hits exactly on a cell edge still find them
+static constexpr float CellPadding = 0.001f;
+
+void ObstacleGrid::Clear()
+{
+    CountX = CountZ = 0;
+    Bounds.clear();
+    CellRanges.clear();
+    CellStarts.clear();
+    CellItems.clear();
+}
+
+void ObstacleGrid::Build(const std::vector<BoundingBox>& obstacleBounds, float cellSize)
+{
+    Clear();
+
+    Bounds = obstacleBounds;
+    if (Bounds.empty())
+        return;
+
+    float maxX = -std::numeric_limits<float>::max();
+    float maxZ = -std::numeric_limits<float>::max();
+    MinX = MinZ = std::numeric_limits<float>::max();
+
+    for (const BoundingBox& bounds : Bounds)
+    {
+        MinX = std::min(MinX, bounds.min.x - CellPadding);
+        MinZ = std::min(MinZ, bounds.min.z - CellPadding);
+        maxX = std::max(maxX, bounds.max.x + CellPadding);
+        maxZ = std::max(maxZ, bounds.max.z + CellPadding);
+    }
+
+    // very spread out maps get bigger cells rather than a huge grid
+    CellSize = std::max(cellSize, std::max(maxX - MinX, maxZ - MinZ) / MaxCellsPerAxis);
+    CountX = std::max(1, int(ceilf((maxX - MinX) / CellSize)));
+    CountZ = std::max(1, int(ceilf((maxZ - MinZ) / CellSize)));
+
+    // count how many obstacles land in each cell, then lay the cells out back to back
+    CellStarts.assign(size_t(CountX) * CountZ + 1, 0);
+    CellRanges.reserve(Bounds.size());
+
+    for (const BoundingBox& bounds : Bounds)
+    {
+        CellRange range = GetCellRange(bounds.min.x - CellPadding, bounds.min.z - CellPadding, bounds.max.x + CellPadding, bounds.max.z + CellPadding);
+        CellRanges.push_back(range);
+
+        for (int z = range.MinZ; z <= range.MaxZ; z++)
+        {
+            for (int x = range.MinX; x <= range.MaxX; x++)
+                CellStarts[z * CountX + x + 1]++;
+        }
+    }
+
+    for (size_t i = 1; i < CellStarts.size(); i++)
+        CellStarts[i] += CellStarts[i - 1];
+
+    CellItems.resize(CellStarts.back());
+    std::vector<int> fill(CellStarts.begin(), CellStarts.end() - 1);
+
+    for (int i = 0; i < int(CellRanges.size()); i++)
+    {
+        const CellRange& range = CellRanges[i];
+        for (int z = range.MinZ; z <= range.MaxZ; z++)
+        {
+            for (int x = range.MinX; x <= range.MaxX; x++)
+                CellItems[fill[z * CountX + x]++] = i;
+        }
+    }
+}
+
+int ObstacleGrid::GetCellX(float x) const
+{
+    return std::clamp(int(floorf((x - MinX) / CellSize)), 0, CountX - 1);
+}
+
+int ObstacleGrid::GetCellZ(float z) const
+{
+    return std::clamp(int(floorf((z - MinZ) / CellSize)), 0, CountZ - 1);
+}
+
+ObstacleGrid::CellRange ObstacleGrid::GetCellRange(float minX, float minZ, float maxX, float maxZ) const
+{
+    return CellRange{ GetCellX(minX), GetCellZ(minZ), GetCellX(maxX), GetCellZ(maxZ) };
+}
+
+void ObstacleGrid::GatherCells(int minX, int minZ, int maxX, int maxZ, std::vector<int>& results) const
+{
+    for (int z = minZ; z <= maxZ; z++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            int cell = z * CountX + x;
+            for (int item = CellStarts[cell]; item < CellStarts[cell + 1]; item++)
+            {
+                int index = CellItems[item];
+
+                // an obstacle that covers several cells is only reported from the first cell it shares with the query
+                const CellRange& range = CellRanges[index];
+                if (x == std::max(range.MinX, minX) && z == std::max(range.MinZ, minZ))
+                    results.push_back(index);
+            }
+        }
+    }
+}
+
+const int* ObstacleGrid::GetCellItems(int cell, int& count) const
+{
+    count = CellStarts[cell + 1] - CellStarts[cell];
+    return CellItems.data() + CellStarts[cell];
+}
+
+void ObstacleGrid::QueryBounds(const BoundingBox& bounds, std::vector<int>& results) const
+{
+    results.clear();
+    if (Bounds.empty())
+        return;
+
+    if (bounds.max.x < MinX || bounds.max.z < MinZ || bounds.min.x > MinX + CountX * CellSize || bounds.min.z > MinZ + CountZ * CellSize)
+        return;
+
+    CellRange range = GetCellRange(bounds.min.x, bounds.min.z, bounds.max.x, bounds.max.z);
+    GatherCells(range.MinX, range.MinZ, range.MaxX, range.MaxZ, results);
+
+    // the cells are coarse, so do the real box test before handing them back
+    results.erase(std::remove_if(results.begin(), results.end(), [&](int index) { return !CheckCollisionBoxes(bounds, Bounds[index]); }), results.end());
+    std::sort(results.begin(), results.end());
+}
+
+ObstacleGrid::RayCursor ObstacleGrid::StartRay(const Ray& ray, float radius) const
+{
+    RayCursor cursor;
+    cursor.Origin = ray.position;
+    cursor.Direction = Vector3Normalize(ray.direction);
+    cursor.Radius = radius;
+
+    if (Bounds.empty() || Vector3LengthSqr(cursor.Direction) == 0)
+        return cursor;
+
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+
+    // clip the ray against the grid on the XZ plane, grown by the radius
+    float gridMin[2] = { MinX - radius, MinZ - radius };
+    float gridMax[2] = { MinX + CountX * CellSize + radius, MinZ + CountZ * CellSize + radius };
+    float origin[2] = { cursor.Origin.x, cursor.Origin.z };
+    float direction[2] = { cursor.Direction.x, cursor.Direction.z };
+
+    float enter = 0;
+    float exit = infinity;
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (direction[axis] == 0)
+        {
+            if (origin[axis] < gridMin[axis] || origin[axis] > gridMax[axis])
+                return cursor;
+            continue;
+        }
+
+        float near = (gridMin[axis] - origin[axis]) / direction[axis];
+        float far = (gridMax[axis] - origin[axis]) / direction[axis];
+        if (near > far)
+            std::swap(near, far);
+
+        enter = std::max(enter, near);
+        exit = std::min(exit, far);
+    }
+
+    if (enter > exit)
+        return cursor;
+
+    cursor.Distance = enter;
+    cursor.EndDistance = exit;
+    cursor.CellX = GetCellX(origin[0] + direction[0] * enter);
+    cursor.CellZ = GetCellZ(origin[1] + direction[1] * enter);
+
+    cursor.StepX = direction[0] > 0 ? 1 : (direction[0] < 0 ? -1 : 0);
+    cursor.StepZ = direction[1] > 0 ? 1 : (direction[1] < 0 ? -1 : 0);
+
+    cursor.NextX = cursor.DeltaX = infinity;
+    if (cursor.StepX != 0)
+    {
+        float edge = MinX + (cursor.CellX + (cursor.StepX > 0 ? 1 : 0)) * CellSize;
+        cursor.NextX = (edge - origin[0]) / direction[0];
+        cursor.DeltaX = CellSize / fabsf(direction[0]);
+    }
+
+    cursor.NextZ = cursor.DeltaZ = infinity;
+    if (cursor.StepZ != 0)
+    {
+        float edge = MinZ + (cursor.CellZ + (cursor.StepZ > 0 ? 1 : 0)) * CellSize;
+        cursor.NextZ = (edge - origin[1]) / direction[1];
+        cursor.DeltaZ = CellSize / fabsf(direction[1]);
+    }
+
+    cursor.Done = false;
+    return cursor;
+}
+
+// step to the next cell along the ray, a thick ray can keep going past the edge cells until it is a radius away from them
+void ObstacleGrid::StepRay(RayCursor& cursor) const
+{
+    if (cursor.ExitDistance >= cursor.EndDistance)
+    {
+        cursor.Done = true;
+    }
+    else if (cursor.NextX < cursor.NextZ)
+    {
+        cursor.Distance = cursor.NextX;
+        cursor.CellX += cursor.StepX;
+        cursor.NextX += cursor.DeltaX;
+        if (cursor.CellX < 0 || cursor.CellX >= CountX)
+        {
+            cursor.CellX -= cursor.StepX;
+            cursor.NextX = std::numeric_limits<float>::infinity();
+        }
+    }
+    else
+    {
+        cursor.Distance = cursor.NextZ;
+        cursor.CellZ += cursor.StepZ;
+        cursor.NextZ += cursor.DeltaZ;
+        if (cursor.CellZ < 0 || cursor.CellZ >= CountZ)
+        {
+            cursor.CellZ -= cursor.StepZ;
+            cursor.NextZ = std::numeric_limits<float>::infinity();
+        }
+    }
+}
+
+bool ObstacleGrid::NextRayCells(RayCursor& cursor, std::vector<int>& results) const
+{
+    results.clear();
+    if (cursor.Done)
+        return false;
+
+    cursor.ExitDistance = std::min(cursor.EndDistance, std::min(cursor.NextX, cursor.NextZ));
+
+    if (cursor.Radius <= 0)
+    {
+        GatherCells(cursor.CellX, cursor.CellZ, cursor.CellX, cursor.CellZ, results);
+    }
+    else
+    {
+        // a thick ray can hit anything within the radius of the part of the ray inside this cell
+        float exit = std::isinf(cursor.ExitDistance) ? cursor.Distance : cursor.ExitDistance;
+        float startX = cursor.Origin.x + cursor.Direction.x * cursor.Distance;
+        float startZ = cursor.Origin.z + cursor.Direction.z * cursor.Distance;
+        float endX = cursor.Origin.x + cursor.Direction.x * exit;
+        float endZ = cursor.Origin.z + cursor.Direction.z * exit;
+
+        CellRange range = GetCellRange(std::min(startX, endX) - cursor.Radius, std::min(startZ, endZ) - cursor.Radius,
+                                       std::max(startX, endX) + cursor.Radius, std::max(startZ, endZ) + cursor.Radius);
+        GatherCells(range.MinX, range.MinZ, range.MaxX, range.MaxZ, results);
+    }
+
+    StepRay(cursor);
+    return true;
+}
+
+bool ObstacleGrid::NextRayCell(RayCursor& cursor, int& cell) const
+{
+    if (cursor.Done)
+        return false;
+
+    cursor.ExitDistance = std::min(cursor.EndDistance, std::min(cursor.NextX, cursor.NextZ));
+    cell = cursor.CellZ * CountX + cursor.CellX;
+
+    StepRay(cursor);
+    return true;
+}
@@ -0,0 +1,304 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include "obstacle_store.h"
+#include "raymath.h"
+
+#ifdef COLLISION_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// the top 3 rows of a matrix, in the order Vector3Transform uses them
+static void GetMatrixRows(const Matrix& matrix, float rows[12])
+{
+    const float values[12] = { matrix.m0, matrix.m4, matrix.m8, matrix.m12,
+                               matrix.m1, matrix.m5, matrix.m9, matrix.m13,
+                               matrix.m2, matrix.m6, matrix.m10, matrix.m14 };
+    for (int i = 0; i < 12; i++)
+        rows[i] = values[i];
+}
+
+void ObstacleStore::Build(const std::vector<Matrix>& inverseMatrices, const std::vector<Matrix>& worldMatrices, const std::vector<BoundingBox>& localBounds)
+{
+    size_t count = localBounds.size();
+    for (int i = 0; i < 12; i++)
+    {
+        Inverse[i].resize(count);
+        World[i].resize(count);
+    }
+    RectX.resize(count);
+    RectZ.resize(count);
+    RectWidth.resize(count);
+    RectDepth.resize(count);
+    MinY.resize(count);
+    MaxY.resize(count);
+
+    for (size_t index = 0; index < count; index++)
+    {
+        float inverseRows[12];
+        float worldRows[12];
+        GetMatrixRows(inverseMatrices[index], inverseRows);
+        GetMatrixRows(worldMatrices[index], worldRows);
+        for (int i = 0; i < 12; i++)
+        {
+            Inverse[i][index] = inverseRows[i];
+            World[i][index] = worldRows[i];
+        }
+
+        const BoundingBox& bounds = localBounds[index];
+        RectX[index] = bounds.min.x;
+        RectZ[index] = bounds.min.z;
+        RectWidth[index] = bounds.max.x - bounds.min.x;
+        RectDepth[index] = bounds.max.z - bounds.min.z;
+        MinY[index] = bounds.min.y;
+        MaxY[index] = bounds.max.y;
+    }
+}
+
+void ObstacleStore::GatherPacket(const int* indices, int count, Packet& packet) const
+{
+    packet.Count = count;
+
+    // the arrays are looked up once, writing the packet could otherwise make the compiler load them again for every value
+    const float* inverse[12];
+    for (int i = 0; i < 12; i++)
+        inverse[i] = Inverse[i].data();
+
+    const float* rectX = RectX.data();
+    const float* rectZ = RectZ.data();
+    const float* rectWidth = RectWidth.data();
+    const float* rectDepth = RectDepth.data();
+    const float* minY = MinY.data();
+    const float* maxY = MaxY.data();
+
+    // short packets repeat their first wall, the extra lanes are never reported
+    for (int lane = 0; lane < PacketSize; lane++)
+    {
+        int index = indices[lane < count ? lane : 0];
+        packet.Index[lane] = index;
+
+        for (int i = 0; i < 12; i++)
+            packet.Inverse[i][lane] = inverse[i][index];
+
+        packet.RectX[lane] = rectX[index];
+        packet.RectZ[lane] = rectZ[index];
+        packet.RectWidth[lane] = rectWidth[index];
+        packet.RectDepth[lane] = rectDepth[index];
+        packet.MinY[lane] = minY[index];
+        packet.MaxY[lane] = maxY[index];
+    }
+}
+
+#ifdef COLLISION_USE_SSE2
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// one row of a packet's matrices times a point, the 4 values of the row are in the next 4 arrays
+static inline __m128 TransformRow(const float (*row)[ObstacleStore::PacketSize], int lane, __m128 x, __m128 y, __m128 z)
+{
+    // summed in the same order as Vector3Transform so the lanes match the scalar test bit for bit
+    return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(row[0] + lane), x), _mm_mul_ps(_mm_load_ps(row[1] + lane), y)),
+                                 _mm_mul_ps(_mm_load_ps(row[2] + lane), z)), _mm_load_ps(row[3] + lane));
+}
+#endif
+
+void ObstacleStore::CollideCylinder(const Packet& packet, Vector3 position, Vector3 oldPosition, float radius, float height, CylinderHits& hits) const
+{
+    // the cylinder pushed out of each wall, in the wall's space
+    alignas(16) float pushedX[PacketSize];
+    alignas(16) float pushedY[PacketSize];
+    alignas(16) float pushedZ[PacketSize];
+    alignas(16) float normalX[PacketSize];
+    alignas(16) float normalY[PacketSize];
+    alignas(16) float normalZ[PacketSize];
+
+    hits.HitMask = 0;
+    hits.ScalarMask = 0;
+
+#ifdef COLLISION_USE_SSE2
+    const __m128 positionX = _mm_set1_ps(position.x);
+    const __m128 positionY = _mm_set1_ps(position.y);
+    const __m128 positionZ = _mm_set1_ps(position.z);
+    const __m128 oldPositionX = _mm_set1_ps(oldPosition.x);
+    const __m128 oldPositionY = _mm_set1_ps(oldPosition.y);
+    const __m128 oldPositionZ = _mm_set1_ps(oldPosition.z);
+    const __m128 radius4 = _mm_set1_ps(radius);
+    const __m128 radiusSquared = _mm_set1_ps(radius * radius);
+    const __m128 height4 = _mm_set1_ps(height);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    // 8 walls are two groups of 4 lanes
+    for (int lane = 0; lane < PacketSize; lane += 4)
+    {
+        __m128 x = TransformRow(packet.Inverse + 0, lane, positionX, positionY, positionZ);
+        __m128 y = TransformRow(packet.Inverse + 4, lane, positionX, positionY, positionZ);
+        __m128 z = TransformRow(packet.Inverse + 8, lane, positionX, positionY, positionZ);
+        __m128 oldY = TransformRow(packet.Inverse + 4, lane, oldPositionX, oldPositionY, oldPositionZ);
+
+        __m128 rectX = _mm_load_ps(packet.RectX + lane);
+        __m128 rectZ = _mm_load_ps(packet.RectZ + lane);
+        __m128 width = _mm_load_ps(packet.RectWidth + lane);
+        __m128 depth = _mm_load_ps(packet.RectDepth + lane);
+        __m128 minY = _mm_load_ps(packet.MinY + lane);
+        __m128 maxY = _mm_load_ps(packet.MaxY + lane);
+
+        // the circle against the rectangle, the same steps as CheckCollisionCircleRec
+        __m128 halfWidth = _mm_mul_ps(width, half);
+        __m128 halfDepth = _mm_mul_ps(depth, half);
+        __m128 dx = _mm_andnot_ps(signBit, _mm_sub_ps(x, _mm_add_ps(rectX, halfWidth)));
+        __m128 dz = _mm_andnot_ps(signBit, _mm_sub_ps(z, _mm_add_ps(rectZ, halfDepth)));
+        __m128 cornerX = _mm_sub_ps(dx, halfWidth);
+        __m128 cornerZ = _mm_sub_ps(dz, halfDepth);
+        __m128 cornerDistance = _mm_add_ps(_mm_mul_ps(cornerX, cornerX), _mm_mul_ps(cornerZ, cornerZ));
+
+        __m128 touching = _mm_and_ps(_mm_cmple_ps(dx, _mm_add_ps(halfWidth, radius4)), _mm_cmple_ps(dz, _mm_add_ps(halfDepth, radius4)));
+        touching = _mm_and_ps(touching, _mm_or_ps(_mm_or_ps(_mm_cmple_ps(dx, halfWidth), _mm_cmple_ps(dz, halfDepth)), _mm_cmple_ps(cornerDistance, radiusSquared)));
+
+        // not above or below
+        __m128 top = _mm_add_ps(y, height4);
+        touching = _mm_and_ps(touching, _mm_and_ps(_mm_cmple_ps(y, maxY), _mm_cmpge_ps(top, minY)));
+
+        // most walls in a packet are nowhere near the cylinder
+        if (_mm_movemask_ps(touching) == 0)
+            continue;
+
+        // landing on top or coming up from under the wall
+        __m128 landing = _mm_and_ps(_mm_cmpgt_ps(oldY, maxY), _mm_cmpgt_ps(oldY, y));
+        __m128 rising = _mm_and_ps(_mm_cmplt_ps(_mm_add_ps(oldY, height4), minY), _mm_cmplt_ps(oldY, y));
+        __m128 scalar = _mm_and_ps(touching, _mm_or_ps(landing, rising));
+
+        // the nearest point on the rectangle, the same steps as PointNearestRectanglePoint
+        __m128 right = _mm_add_ps(rectX, width);
+        __m128 far = _mm_add_ps(rectZ, depth);
+
+        __m128 pastRight = _mm_cmpgt_ps(x, right);
+        __m128 sideX = Select(pastRight, right, rectX);
+        __m128 sideNormal = Select(pastRight, one, minusOne);
+        __m128 alongZ = _mm_sub_ps(z, rectZ);
+        __m128 sideZ = Select(_mm_cmplt_ps(alongZ, zero), rectZ, Select(_mm_cmpge_ps(alongZ, depth), far, _mm_add_ps(rectZ, alongZ)));
+
+        __m128 pastFar = _mm_cmpgt_ps(z, far);
+        __m128 endZ = Select(pastFar, far, rectZ);
+        __m128 endNormal = Select(pastFar, one, minusOne);
+        __m128 alongX = _mm_sub_ps(x, rectX);
+        __m128 endX = Select(_mm_cmplt_ps(alongX, zero), rectX, Select(_mm_cmpge_ps(alongX, width), right, _mm_add_ps(rectX, alongX)));
+
+        __m128 sideOffsetX = _mm_sub_ps(x, sideX);
+        __m128 sideOffsetZ = _mm_sub_ps(z, sideZ);
+        __m128 endOffsetX = _mm_sub_ps(x, endX);
+        __m128 endOffsetZ = _mm_sub_ps(z, endZ);
+        __m128 useSide = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(sideOffsetX, sideOffsetX), _mm_mul_ps(sideOffsetZ, sideOffsetZ)),
+                                      _mm_add_ps(_mm_mul_ps(endOffsetX, endOffsetX), _mm_mul_ps(endOffsetZ, endOffsetZ)));
+
+        __m128 hitX = Select(useSide, sideX, endX);
+        __m128 hitZ = Select(useSide, sideZ, endZ);
+
+        // only a hit if the nearest point is inside the circle
+        __m128 toHitX = _mm_sub_ps(hitX, x);
+        __m128 toHitZ = _mm_sub_ps(hitZ, z);
+        __m128 toHitLength = _mm_add_ps(_mm_mul_ps(toHitX, toHitX), _mm_mul_ps(toHitZ, toHitZ));
+        __m128 hit = _mm_andnot_ps(scalar, _mm_and_ps(touching, _mm_cmplt_ps(toHitLength, radiusSquared)));
+
+        // push the deepest point of the circle out to the nearest side, along that side's normal only
+        toHitLength = _mm_sqrt_ps(toHitLength);
+        __m128 hasLength = _mm_cmpgt_ps(toHitLength, zero);
+        __m128 inverseLength = _mm_div_ps(one, toHitLength);
+        __m128 deepestX = _mm_add_ps(x, _mm_mul_ps(_mm_and_ps(hasLength, _mm_mul_ps(toHitX, inverseLength)), radius4));
+        __m128 deepestZ = _mm_add_ps(z, _mm_mul_ps(_mm_and_ps(hasLength, _mm_mul_ps(toHitZ, inverseLength)), radius4));
+
+        _mm_store_ps(pushedX + lane, _mm_add_ps(x, _mm_and_ps(useSide, _mm_sub_ps(hitX, deepestX))));
+        _mm_store_ps(pushedY + lane, y);
+        _mm_store_ps(pushedZ + lane, _mm_add_ps(z, _mm_andnot_ps(useSide, _mm_sub_ps(hitZ, deepestZ))));
+        _mm_store_ps(normalX + lane, _mm_and_ps(useSide, sideNormal));
+        _mm_store_ps(normalY + lane, zero);
+        _mm_store_ps(normalZ + lane, _mm_andnot_ps(useSide, endNormal));
+
+        hits.HitMask |= _mm_movemask_ps(hit) << lane;
+        hits.ScalarMask |= _mm_movemask_ps(scalar) << lane;
+    }
+#else
+    for (int lane = 0; lane < PacketSize; lane++)
+    {
+        Matrix inverse = { packet.Inverse[0][lane], packet.Inverse[1][lane], packet.Inverse[2][lane], packet.Inverse[3][lane],
+                           packet.Inverse[4][lane], packet.Inverse[5][lane], packet.Inverse[6][lane], packet.Inverse[7][lane],
+                           packet.Inverse[8][lane], packet.Inverse[9][lane], packet.Inverse[10][lane], packet.Inverse[11][lane],
+                           0, 0, 0, 1 };
+
+        Vector3 local = Vector3Transform(position, inverse);
+        Vector3 localOld = Vector3Transform(oldPosition, inverse);
+
+        BoundingBox bounds = { { packet.RectX[lane], packet.MinY[lane], packet.RectZ[lane] },
+                               { packet.RectX[lane] + packet.RectWidth[lane], packet.MaxY[lane], packet.RectZ[lane] + packet.RectDepth[lane] } };
+
+        // without SIMD every lane takes the scalar test, so none are left for the caller
+        Vector3 nearest = { 0 };
+        Vector3 normal = { 0 };
+        if (!IntersectBBoxCylinder(bounds, local, localOld, radius, height, nearest, normal))
+            continue;
+
+        pushedX[lane] = local.x;
+        pushedY[lane] = local.y;
+        pushedZ[lane] = local.z;
+        normalX[lane] = normal.x;
+        normalY[lane] = normal.y;
+        normalZ[lane] = normal.z;
+        hits.HitMask |= 1 << lane;
+    }
+#endif
+
+    // the lanes past the end of a short packet are copies
+    int validMask = (1 << packet.Count) - 1;
+    hits.HitMask &= validMask;
+    hits.ScalarMask &= validMask;
+
+    // hits are rare, so the pushed cylinders go back to world space one at a time
+    for (int lane = 0; lane < PacketSize; lane++)
+    {
+        if (!(hits.HitMask & (1 << lane)))
+            continue;
+
+        int index = packet.Index[lane];
+        Matrix world = { World[0][index], World[1][index], World[2][index], World[3][index],
+                         World[4][index], World[5][index], World[6][index], World[7][index],
+                         World[8][index], World[9][index], World[10][index], World[11][index],
+                         0, 0, 0, 1 };
+
+        Vector3 pushed = Vector3Transform(Vector3{ pushedX[lane], pushedY[lane], pushedZ[lane] }, world);
+        hits.Push[lane] = Vector3Subtract(pushed, position);
+
+        // the normal only turns, it doesn't move
+        world.m12 = world.m13 = world.m14 = 0;
+        hits.Normal[lane] = Vector3Transform(Vector3{ normalX[lane], normalY[lane], normalZ[lane] }, world);
+    }
+}
@@ -0,0 +1,539 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include "collisions.h"
+#include "map.h"
+#include "obstacle_grid.h"
+#include "obstacle_store.h"
+#include "transform_graph.h"
+#include "wall_packets.h"
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// checks the collision code against answers worked out by hand, and the grid and SIMD packets against testing every wall one at a time
+// prints each failed check and exits with 1 if there were any
+
+static int Checks = 0;
+static int Failures = 0;
+
+static void Check(bool passed, const char* name)
+{
+    Checks++;
+    if (passed)
+        return;
+
+    printf("failed: %s\n", name);
+    Failures++;
+}
+
+static bool Near(float value, float expected, float tolerance = 0.001f)
+{
+    return fabsf(value - expected) <= tolerance * std::max(1.0f, fabsf(expected));
+}
+
+static bool Near(Vector3 value, Vector3 expected, float tolerance = 0.001f)
+{
+    return Near(value.x, expected.x, tolerance) && Near(value.y, expected.y, tolerance) && Near(value.z, expected.z, tolerance);
+}
+
+static float RandomFloat(float min, float max)
+{
+    return min + (max - min) * (GetRandomValue(0, 100000) / 100000.0f);
+}
+
+// a field of random walls, close enough together that they often overlap
+static void BuildRandomWalls(std::vector<Obstacle>& walls, int count, float fieldSize)
+{
+    float halfSize = fieldSize * 0.5f;
+    for (int i = 0; i < count; i++)
+        walls.emplace_back(RandomFloat(-halfSize, halfSize), RandomFloat(-halfSize, halfSize), RandomFloat(0.2f, 4), RandomFloat(1, 5), RandomFloat(1, 12), RandomFloat(-180, 180));
+}
+
+static void TestIntersectBBoxCylinder()
+{
+    BoundingBox box = { { -1, 0, -1 }, { 1, 2, 1 } };
+    Vector3 point = { 0 };
+    Vector3 normal = { 0 };
+
+    // overlapping the +X side by a quarter, pushed back out along X
+    Vector3 center = { 1.25f, 0.5f, 0 };
+    Check(IntersectBBoxCylinder(box, center, Vector3{ 2, 0.5f, 0 }, 0.5f, 1, point, normal), "IntersectBBoxCylinder side hit");
+    Check(Near(center, Vector3{ 1.5f, 0.5f, 0 }), "IntersectBBoxCylinder side push");
+    Check(Near(normal, Vector3{ 1, 0, 0 }), "IntersectBBoxCylinder side normal");
+
+    // just clear of the side, above the top and below the bottom
+    center = Vector3{ 1.6f, 0.5f, 0 };
+    Check(!IntersectBBoxCylinder(box, center, center, 0.5f, 1, point, normal), "IntersectBBoxCylinder side miss");
+    Check(Near(center, Vector3{ 1.6f, 0.5f, 0 }), "IntersectBBoxCylinder miss leaves the center alone");
+
+    center = Vector3{ 0, 2.1f, 0 };
+    Check(!IntersectBBoxCylinder(box, center, center, 0.5f, 1, point, normal), "IntersectBBoxCylinder above");
+
+    center = Vector3{ 0, -1.1f, 0 };
+    Check(!IntersectBBoxCylinder(box, center, center, 0.5f, 1, point, normal), "IntersectBBoxCylinder below");
+
+    // the corner is a circle, a cylinder diagonally off it but inside the square around it is clear
+    center = Vector3{ 1.4f, 0.5f, 1.4f };
+    Check(!IntersectBBoxCylinder(box, center, center, 0.5f, 1, point, normal), "IntersectBBoxCylinder corner miss");
+}
+
+static void TestSweepCylinderBBox()
+{
+    BoundingBox box = { { -1, 0, -1 }, { 1, 2, 1 } };
+    float hitTime = 0;
+    Vector3 normal = { 0 };
+
+    // the side of the cylinder reaches the -X face after 3.5 of the 10 units
+    Check(SweepCylinderBBox(box, Vector3{ -5, 0.5f, 0 }, Vector3{ 10, 0, 0 }, 0.5f, 1, hitTime, normal), "SweepCylinderBBox side hit");
+    Check(Near(hitTime, 0.35f), "SweepCylinderBBox side time");
+    Check(Near(normal, Vector3{ -1, 0, 0 }), "SweepCylinderBBox side normal");
+
+    // falling onto the top, the base reaches it after 1 of the 2 units
+    Check(SweepCylinderBBox(box, Vector3{ 0, 3, 0 }, Vector3{ 0, -2, 0 }, 0.5f, 1, hitTime, normal), "SweepCylinderBBox top hit");
+    Check(Near(hitTime, 0.5f), "SweepCylinderBBox top time");
+    Check(Near(normal, Vector3{ 0, 1, 0 }), "SweepCylinderBBox top normal");
+
+    // passing beside the box, and stopping short of it
+    Check(!SweepCylinderBBox(box, Vector3{ -5, 0.5f, 1.6f }, Vector3{ 10, 0, 0 }, 0.5f, 1, hitTime, normal), "SweepCylinderBBox pass beside");
+    Check(!SweepCylinderBBox(box, Vector3{ -5, 0.5f, 0 }, Vector3{ 3, 0, 0 }, 0.5f, 1, hitTime, normal), "SweepCylinderBBox stop short");
+
+    // touching a side and moving away from it is not a hit
+    Check(!SweepCylinderBBox(box, Vector3{ 1.5f, 0.5f, 0 }, Vector3{ 1, 0, 0 }, 0.5f, 1, hitTime, normal), "SweepCylinderBBox move away");
+}
+
+static void TestSphereCastBBox()
+{
+    BoundingBox box = { { -1, -1, -1 }, { 1, 1, 1 } };
+    float distance = 0;
+    Vector3 normal = { 0 };
+
+    // head on into the -X face
+    Check(SphereCastBBox(box, Ray{ { -5, 0, 0 }, { 1, 0, 0 } }, 0.5f, 10, distance, normal), "SphereCastBBox face hit");
+    Check(Near(distance, 3.5f), "SphereCastBBox face distance");
+    Check(Near(normal, Vector3{ -1, 0, 0 }), "SphereCastBBox face normal");
+
+    // passing over the top edge a quarter up, it touches the rounded edge sqrt(0.5^2 - 0.25^2) before the face
+    Check(SphereCastBBox(box, Ray{ { -5, 1.25f, 0 }, { 1, 0, 0 } }, 0.5f, 10, distance, normal), "SphereCastBBox edge hit");
+    Check(Near(distance, 4 - sqrtf(0.5f * 0.5f - 0.25f * 0.25f)), "SphereCastBBox edge distance");
+
+    // too high to touch, and too far away
+    Check(!SphereCastBBox(box, Ray{ { -5, 1.6f, 0 }, { 1, 0, 0 } }, 0.5f, 10, distance, normal), "SphereCastBBox pass over");
+    Check(!SphereCastBBox(box, Ray{ { -5, 0, 0 }, { 1, 0, 0 } }, 0.5f, 3, distance, normal), "SphereCastBBox out of range");
+
+    // already touching
+    Check(SphereCastBBox(box, Ray{ { -1.25f, 0, 0 }, { 1, 0, 0 } }, 0.5f, 10, distance, normal) && Near(distance, 0), "SphereCastBBox starts touching");
+}
+
+static OrientedBox MakeOrientedBox(Vector3 center, Vector3 axisX, Vector3 axisY, Vector3 axisZ)
+{
+    OrientedBox box;
+    box.Center = center;
+    box.Axes[0] = axisX;
+    box.Axes[1] = axisY;
+    box.Axes[2] = axisZ;
+    box.HalfExtents = Vector3{ 1, 1, 1 };
+    return box;
+}
+
+static void TestOrientedBoxes()
+{
+    const float s = sqrtf(0.5f);
+    OrientedBox box = MakeOrientedBox(Vector3{ 0, 0, 0 }, Vector3{ 1, 0, 0 }, Vector3{ 0, 1, 0 }, Vector3{ 0, 0, 1 });
+
+    // 2 unit cubes side by side
+    Check(CheckCollisionOrientedBoxes(box, MakeOrientedBox(Vector3{ 1.9f, 0, 0 }, Vector3{ 1, 0, 0 }, Vector3{ 0, 1, 0 }, Vector3{ 0, 0, 1 })), "CheckCollisionOrientedBoxes faces overlap");
+    Check(!CheckCollisionOrientedBoxes(box, MakeOrientedBox(Vector3{ 2.1f, 0, 0 }, Vector3{ 1, 0, 0 }, Vector3{ 0, 1, 0 }, Vector3{ 0, 0, 1 })), "CheckCollisionOrientedBoxes faces apart");
+
+    // a cube turned 45 degrees about Y reaches sqrt(2) toward the other with its edge
+    Check(CheckCollisionOrientedBoxes(box, MakeOrientedBox(Vector3{ 2.3f, 0, 0 }, Vector3{ s, 0, -s }, Vector3{ 0, 1, 0 }, Vector3{ s, 0, s })), "CheckCollisionOrientedBoxes turned overlap");
+    Check(!CheckCollisionOrientedBoxes(box, MakeOrientedBox(Vector3{ 2.5f, 0, 0 }, Vector3{ s, 0, -s }, Vector3{ 0, 1, 0 }, Vector3{ s, 0, s })), "CheckCollisionOrientedBoxes turned apart");
+
+    // cubes turned about Z and about X meet edge to edge at a height of 2 sqrt(2)
+    // just below that no face separates them, only the cross product of the 2 edges does
+    OrientedBox turnedZ = MakeOrientedBox(Vector3{ 0, 0, 0 }, Vector3{ s, s, 0 }, Vector3{ -s, s, 0 }, Vector3{ 0, 0, 1 });
+    Check(CheckCollisionOrientedBoxes(turnedZ, MakeOrientedBox(Vector3{ 0, 2.7f, 0 }, Vector3{ 1, 0, 0 }, Vector3{ 0, s, s }, Vector3{ 0, -s, s })), "CheckCollisionOrientedBoxes edges overlap");
+    Check(!CheckCollisionOrientedBoxes(turnedZ, MakeOrientedBox(Vector3{ 0, 2.9f, 0 }, Vector3{ 1, 0, 0 }, Vector3{ 0, s, s }, Vector3{ 0, -s, s })), "CheckCollisionOrientedBoxes edges apart");
+
+    // a box built from a wall's bounds and matrix is the wall, scale goes into the extents
+    Obstacle wall(3, 4, 2, 3, 6, 30);
+    OrientedBox wallBox = OrientedBoxFromBounds(BoundingBox{ { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } }, MatrixMultiply(MatrixScale(2, 3, 6), wall.GetWorldMatrix()));
+    Check(Near(wallBox.Center, wall.GetWorldBox().Center) && Near(wallBox.HalfExtents, Vector3{ 1, 1.5f, 3 }), "OrientedBoxFromBounds takes the scale out of the axes");
+    Check(Near(wallBox.Center, Vector3{ 3, 1.5f, 4 }), "OrientedBoxFromBounds center");
+}
+
+static void TestGridQuery()
+{
+    std::vector<BoundingBox> bounds;
+    for (int i = 0; i < 500; i++)
+    {
+        Vector3 center = { RandomFloat(-100, 100), RandomFloat(0, 4), RandomFloat(-100, 100) };
+        Vector3 size = { RandomFloat(0.1f, 20), RandomFloat(0.1f, 4), RandomFloat(0.1f, 20) };
+        bounds.push_back(BoundingBox{ Vector3Subtract(center, size), Vector3Add(center, size) });
+    }
+
+    ObstacleGrid grid;
+    grid.Build(bounds);
+
+    int mismatches = 0;
+    std::vector<int> results;
+    for (int i = 0; i < 2000; i++)
+    {
+        // some queries hang off the edge of the grid or miss it completely
+        Vector3 center = { RandomFloat(-130, 130), RandomFloat(-2, 6), RandomFloat(-130, 130) };
+        Vector3 size = { RandomFloat(0, 15), RandomFloat(0, 3), RandomFloat(0, 15) };
+        BoundingBox query = { Vector3Subtract(center, size), Vector3Add(center, size) };
+
+        grid.QueryBounds(query, results);
+
+        std::vector<int> expected;
+        for (int index = 0; index < int(bounds.size()); index++)
+        {
+            if (CheckCollisionBoxes(query, bounds[index]))
+                expected.push_back(index);
+        }
+
+        if (results != expected)
+            mismatches++;
+    }
+
+    Check(mismatches == 0, "ObstacleGrid::QueryBounds matches testing every box");
+}
+
+static void TestWallPackets()
+{
+    std::vector<Obstacle> walls;
+    BuildRandomWalls(walls, 400, 120);
+
+    std::vector<BoundingBox> worldBounds;
+    std::vector<BoundingBox> localBounds;
+    std::vector<Matrix> inverseMatrices;
+    for (Obstacle& wall : walls)
+    {
+        worldBounds.push_back(wall.GetWorldBounds());
+        localBounds.push_back(wall.Bounds);
+        inverseMatrices.push_back(wall.GetInverseWorldMatrix());
+    }
+
+    ObstacleGrid grid;
+    grid.Build(worldBounds);
+
+    WallPackets packets;
+    packets.Build(grid, inverseMatrices, localBounds);
+
+    int mismatches = 0;
+    for (int i = 0; i < 2000; i++)
+    {
+        Ray ray = { { RandomFloat(-70, 70), RandomFloat(0.1f, 4), RandomFloat(-70, 70) } };
+        ray.direction = Vector3Normalize(Vector3{ RandomFloat(-1, 1), RandomFloat(-0.2f, 0.2f), RandomFloat(-1, 1) });
+
+        float distance = 0;
+        int hitWall = packets.CastRay(grid, ray, distance);
+
+        float nearest = 0;
+        int nearestWall = -1;
+        for (int index = 0; index < int(walls.size()); index++)
+        {
+            RayCollision collision = { 0 };
+            if (walls[index].CheckRaycast(ray, collision) && (nearestWall < 0 || collision.distance < nearest))
+            {
+                nearest = collision.distance;
+                nearestWall = index;
+            }
+        }
+
+        // walls can overlap, so two walls can be hit at the same distance and only the distance is compared
+        if ((hitWall < 0) != (nearestWall < 0) || (hitWall >= 0 && !Near(distance, nearest)))
+            mismatches++;
+    }
+
+    Check(mismatches == 0, "WallPackets::CastRay matches Obstacle::CheckRaycast on every wall");
+}
+
+static void TestObstacleStore()
+{
+    constexpr float radius = 1.5f;
+    constexpr float height = 2.0f;
+
+    std::vector<Obstacle> walls;
+    BuildRandomWalls(walls, 64, 40);
+
+    std::vector<Matrix> inverseMatrices;
+    std::vector<Matrix> worldMatrices;
+    std::vector<BoundingBox> localBounds;
+    for (Obstacle& wall : walls)
+    {
+        inverseMatrices.push_back(wall.GetInverseWorldMatrix());
+        worldMatrices.push_back(wall.GetWorldMatrix());
+        localBounds.push_back(wall.Bounds);
+    }
+
+    ObstacleStore store;
+    store.Build(inverseMatrices, worldMatrices, localBounds);
+
+    int mismatches = 0;
+    for (int i = 0; i < 2000; i++)
+    {
+        // the packet is a few random walls, and the cylinder is put next to the first one
+        int indices[ObstacleStore::PacketSize];
+        int count = GetRandomValue(1, ObstacleStore::PacketSize);
+        for (int lane = 0; lane < count; lane++)
+            indices[lane] = GetRandomValue(0, int(walls.size()) - 1);
+
+        Obstacle& near = walls[indices[0]];
+        BoundingBox reach = near.Bounds + Vector3{ radius, 0, radius };
+        Vector3 local = { RandomFloat(reach.min.x, reach.max.x), RandomFloat(reach.min.y - height - 0.5f, reach.max.y + 0.5f), RandomFloat(reach.min.z, reach.max.z) };
+        Vector3 localOld = Vector3Add(local, Vector3{ RandomFloat(-0.5f, 0.5f), RandomFloat(-1, 1), RandomFloat(-0.5f, 0.5f) });
+        Vector3 position = Vector3Transform(local, near.GetWorldMatrix());
+        Vector3 oldPosition = Vector3Transform(localOld, near.GetWorldMatrix());
+
+        ObstacleStore::Packet packet;
+        ObstacleStore::CylinderHits hits;
+        store.GatherPacket(indices, count, packet);
+        store.CollideCylinder(packet, position, oldPosition, radius, height, hits);
+
+        // each lane against the wall on its own, moved the same way Obstacle::CollideWithPlayer moves it
+        for (int lane = 0; lane < count; lane++)
+        {
+            Obstacle& wall = walls[indices[lane]];
+            Vector3 moved = position;
+            bool hit = wall.CollideWithPlayer(moved, oldPosition, radius, height);
+
+            // landing on top and coming up from below are left to the scalar test, so only the hit can be checked
+            bool storeHit = (hits.HitMask | hits.ScalarMask) & (1 << lane);
+            if (storeHit != hit)
+                mismatches++;
+            else if ((hits.HitMask & (1 << lane)) && !Near(Vector3Add(position, hits.Push[lane]), moved))
+                mismatches++;
+        }
+    }
+
+    Check(mismatches == 0, "ObstacleStore::CollideCylinder matches Obstacle::CollideWithPlayer for every lane");
+}
+
+// the player cylinder pushed by every wall in order, the way Map::CollidePlayer did before it had a grid
+static bool CollideEveryWall(Map& map, Vector3& position, Vector3 oldPosition, float radius, float height)
+{
+    bool hit = false;
+    for (Obstacle& wall : map.Walls)
+        hit |= wall.CollideWithPlayer(position, oldPosition, radius, height);
+
+    return hit;
+}
+
+static void TestCollidePlayer()
+{
+    constexpr float radius = 0.5f;
+    constexpr float height = 2.0f;
+
+    // the first two walls each push the player almost a radius along +X, into a third wall too far away for the query around the move to find
+    // that wall pushes the player back a little, the same as when every wall was tested
+    Map map;
+    map.Walls.emplace_back(-1.005f, 0.0f, 1.99f, 3.0f, 10.0f, 0.0f);
+    map.Walls.emplace_back(-0.76f, 0.0f, 2.48f, 3.0f, 10.0f, 0.0f);
+    map.Walls.emplace_back(2.1f, 0.0f, 1.8f, 3.0f, 10.0f, 0.0f);
+    map.WallsChanged();
+
+    Vector3 position = { 0, 0, 0 };
+    Check(map.CollidePlayer(position, position, radius, height), "Map::CollidePlayer chained push hit");
+    Check(Near(position, Vector3{ 0.7f, 0, 0 }), "Map::CollidePlayer chained push reaches a wall outside the query");
+
+    // players starting anywhere in a crowded field, often inside walls, against pushing by every wall in order
+    Map field;
+    BuildRandomWalls(field.Walls, 300, 60);
+    field.WallsChanged();
+
+    int mismatches = 0;
+    for (int i = 0; i < 2000; i++)
+    {
+        Vector3 oldPosition = { RandomFloat(-30, 30), 0, RandomFloat(-30, 30) };
+        Vector3 newPosition = Vector3Add(oldPosition, Vector3{ RandomFloat(-0.5f, 0.5f), 0, RandomFloat(-0.5f, 0.5f) });
+        float playerRadius = RandomFloat(0.25f, 1.5f);
+
+        Vector3 expected = newPosition;
+        bool expectedHit = CollideEveryWall(field, expected, oldPosition, playerRadius, height);
+        bool hit = field.CollidePlayer(newPosition, oldPosition, playerRadius, height);
+        if (hit != expectedHit || !Near(newPosition, expected))
+            mismatches++;
+    }
+
+    Check(mismatches == 0, "Map::CollidePlayer matches pushing by every wall in order");
+}
+
+static void TestCollideRays()
+{
+    // the walls live in a graph with a node that moves before every batch, so the graph is dirty when the batch starts
+    Map map;
+    BuildRandomWalls(map.Walls, 300, 120);
+
+    TransformGraph graph;
+    for (Obstacle& wall : map.Walls)
+        wall.Transform.MoveToGraph(graph);
+
+    int mover = graph.AddNode();
+    map.WallsChanged();
+
+    // big enough that the batch is split across the worker threads
+    std::vector<Ray> rays(8192);
+    std::vector<RayCollision> hits(rays.size());
+
+    int mismatches = 0;
+    int wrongWalls = 0;
+    int dirtyBatches = 0;
+    for (int batch = 0; batch < 4; batch++)
+    {
+        graph.SetPosition(mover, Vector3{ float(batch), 0, 0 });
+
+        for (Ray& ray : rays)
+        {
+            ray.position = Vector3{ RandomFloat(-70, 70), RandomFloat(0.1f, 4), RandomFloat(-70, 70) };
+            ray.direction = Vector3Normalize(Vector3{ RandomFloat(-1, 1), RandomFloat(-0.2f, 0.2f), RandomFloat(-1, 1) });
+        }
+
+        map.CollideRays(rays.data(), hits.data(), rays.size());
+        if (graph.IsDirty())
+            dirtyBatches++;
+
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            RayCollision collision = { 0 };
+            Obstacle* hitWall = nullptr;
+            map.CollideRay(rays[i], collision, &hitWall);
+            if (collision.hit != hits[i].hit || (collision.hit && (!Near(collision.distance, hits[i].distance) || !Near(collision.point, hits[i].point))))
+                mismatches++;
+
+            // the wall given back is the one that was hit
+            RayCollision wallCollision = { 0 };
+            if (collision.hit != (hitWall != nullptr) || (hitWall != nullptr && (!hitWall->CheckRaycast(rays[i], wallCollision) || wallCollision.distance != collision.distance)))
+                wrongWalls++;
+        }
+    }
+
+    Check(dirtyBatches == 0, "Map::CollideRays updates a dirty wall graph before the workers start");
+    Check(mismatches == 0, "Map::CollideRays matches Map::CollideRay with the walls in a graph");
+    Check(wrongWalls == 0, "Map::CollideRay gives back the wall it hit");
+
+    // thick rays can't use the packets, but must still match a thick CollideRay
+    const float radius = 0.5f;
+    map.CollideRays(rays.data(), hits.data(), rays.size(), radius);
+
+    int thickMismatches = 0;
+    for (size_t i = 0; i < rays.size(); i++)
+    {
+        RayCollision collision = { 0 };
+        map.CollideRay(rays[i], collision, nullptr, radius);
+        if (collision.hit != hits[i].hit || (collision.hit && (!Near(collision.distance, hits[i].distance) || !Near(collision.point, hits[i].point))))
+            thickMismatches++;
+    }
+
+    Check(thickMismatches == 0, "Map::CollideRays with a radius matches Map::CollideRay with the same radius");
+}
+
+static bool NearMatrix(const Matrix& value, const Matrix& expected)
+{
+    const float* values = &value.m0;
+    const float* expectedValues = &expected.m0;
+    for (int i = 0; i < 16; i++)
+    {
+        if (!Near(values[i], expectedValues[i]))
+            return false;
+    }
+
+    return true;
+}
+
+static void TestTransformGraph()
+{
+    // the same 3 level hierarchy with parent pointers and in a graph, moved into the graph from the bottom
+    ObjectTransform pointerRoot;
+    ObjectTransform pointerMiddle;
+    ObjectTransform pointerLeaf;
+    ObjectTransform graphRoot;
+    ObjectTransform graphMiddle;
+    ObjectTransform graphLeaf;
+
+    pointerRoot.AddChild(pointerMiddle).AddChild(pointerLeaf);
+    graphRoot.AddChild(graphMiddle).AddChild(graphLeaf);
+
+    ObjectTransform* pointerNodes[] = { &pointerRoot, &pointerMiddle, &pointerLeaf };
+    ObjectTransform* graphNodes[] = { &graphRoot, &graphMiddle, &graphLeaf };
+    for (int i = 0; i < 3; i++)
+    {
+        pointerNodes[i]->SetPosition(float(i + 1), 0, 0);
+        pointerNodes[i]->RotateV(30);
+        graphNodes[i]->SetPosition(float(i + 1), 0, 0);
+        graphNodes[i]->RotateV(30);
+    }
+
+    // the leaf can't follow parents that are left outside of the graph, so they come in with it
+    TransformGraph graph;
+    graphLeaf.MoveToGraph(graph);
+    Check(graphRoot.GetGraph() == &graph && graphMiddle.GetGraph() == &graph, "MoveToGraph brings the parents into the graph");
+
+    pointerRoot.MovePosition(0, 0, 2);
+    graphRoot.MovePosition(0, 0, 2);
+    Check(NearMatrix(graphLeaf.GetWorldMatrix(), pointerLeaf.GetWorldMatrix()), "MoveToGraph leaf follows its root");
+
+    // a graph node put under a plain transform pulls that transform into the graph, and follows it from then on
+    ObjectTransform pointerHolder;
+    ObjectTransform graphHolder;
+    pointerHolder.SetPosition(0, 5, 0);
+    graphHolder.SetPosition(0, 5, 0);
+
+    pointerHolder.AddChild(pointerRoot);
+    graphHolder.AddChild(graphRoot);
+    Check(graphHolder.GetGraph() == &graph, "Reparent under a plain transform brings it into the graph");
+
+    pointerHolder.RotateV(45);
+    graphHolder.RotateV(45);
+    Check(NearMatrix(graphLeaf.GetWorldMatrix(), pointerLeaf.GetWorldMatrix()), "Reparent leaf follows the new parent");
+}
+
+int main()
+{
+    SetRandomSeed(1234);
+
+    TestIntersectBBoxCylinder();
+    TestSweepCylinderBBox();
+    TestSphereCastBBox();
+    TestOrientedBoxes();
+    TestGridQuery();
+    TestWallPackets();
+    TestObstacleStore();
+    TestCollidePlayer();
+    TestCollideRays();
+    TestTransformGraph();
+
+    printf("%d of %d collision checks passed\n", Checks - Failures, Checks);
+    return Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(size_t workerCount)
+{
+    if (workerCount == 0)
+    {
+        size_t cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 0;
+    }
+
+    for (size_t i = 0; i < workerCount; i++)
+        Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(Lock);
+        Quit = true;
+    }
+    WakeWorkers.notify_all();
+
+    for (std::thread& worker : Workers)
+        worker.join();
+}
+
+void ThreadPool::Run(size_t taskCount, const std::function<void(size_t)>& task)
+{
+    if (taskCount == 0)
+        return;
+
+    // with no workers, or nothing to split up, just do the work here
+    if (Workers.empty() || taskCount == 1)
+    {
+        for (size_t i = 0; i < taskCount; i++)
+            task(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(Lock);
+        Task = &task;
+        TaskCount = taskCount;
+        NextTask = 0;
+        BusyWorkers = Workers.size();
+        JobId++;
+    }
+    WakeWorkers.notify_all();
+
+    // help out while the workers run
+    RunTasks();
+
+    // wait for the workers to finish the tasks they took
+    std::unique_lock<std::mutex> guard(Lock);
+    WorkersDone.wait(guard, [this]() { return BusyWorkers == 0; });
+    Task = nullptr;
+}
+
+void ThreadPool::RunTasks()
+{
+    // every thread pulls the next task number until they are all taken
+    for (size_t index = NextTask++; index < TaskCount; index = NextTask++)
+        (*Task)(index);
+}
+
+void ThreadPool::WorkerLoop()
+{
+    size_t lastJob = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(Lock);
+            WakeWorkers.wait(guard, [this, lastJob]() { return Quit || JobId != lastJob; });
+
+            if (Quit)
+                return;
+
+            lastJob = JobId;
+        }
+
+        RunTasks();
+
+        {
+            std::lock_guard<std::mutex> guard(Lock);
+            BusyWorkers--;
+        }
+        WorkersDone.notify_one();
+    }
+}
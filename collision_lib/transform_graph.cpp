@@ -0,0 +1,185 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include "transform_graph.h"
+
+#include <algorithm>
+
+int TransformGraph::AddNode(int parent, unsigned int version)
+{
+    int node = int(Slots.size());
+    int slot = int(Nodes.size());
+
+    // new nodes go on the end, so they are always after their parent
+    Parents.push_back(parent == NoParent ? NoParent : Slots[parent]);
+    Positions.push_back(Vector3Zero());
+    Orientations.push_back(QuaternionIdentity());
+    WorldMatrices.push_back(MatrixIdentity());
+    Changed.push_back(1);
+    Versions.push_back(version);
+
+    Slots.push_back(slot);
+    Nodes.push_back(node);
+
+    Dirty = true;
+    return node;
+}
+
+bool TransformGraph::SetParent(int node, int parent)
+{
+    int slot = Slots[node];
+    int parentSlot = parent == NoParent ? NoParent : Slots[parent];
+
+    // a node can't end up under itself
+    for (int above = parentSlot; above != NoParent; above = Parents[above])
+    {
+        if (above == slot)
+            return false;
+    }
+
+    Parents[slot] = parentSlot;
+    Changed[slot] = 1;
+    Dirty = true;
+
+    if (parentSlot > slot)
+        Sorted = false;
+
+    return true;
+}
+
+int TransformGraph::GetParent(int node) const
+{
+    int parentSlot = Parents[Slots[node]];
+    return parentSlot == NoParent ? NoParent : Nodes[parentSlot];
+}
+
+void TransformGraph::Clear()
+{
+    Parents.clear();
+    Positions.clear();
+    Orientations.clear();
+    WorldMatrices.clear();
+    Changed.clear();
+    Versions.clear();
+    Slots.clear();
+    Nodes.clear();
+
+    Dirty = false;
+    Sorted = true;
+}
+
+void TransformGraph::UpdateWorldMatrices()
+{
+    if (!Sorted)
+        Sort();
+
+    // parents come first, so a parent's change flag and world matrix are final by the time its children are reached
+    size_t count = Parents.size();
+    for (size_t slot = 0; slot < count; slot++)
+    {
+        int parent = Parents[slot];
+        if (parent != NoParent && Changed[parent])
+            Changed[slot] = 1;
+
+        if (!Changed[slot])
+            continue;
+
+        Matrix local = TransformLocalMatrix(Positions[slot], Orientations[slot]);
+        WorldMatrices[slot] = parent == NoParent ? local : MatrixMultiply(local, WorldMatrices[parent]);
+        Versions[slot]++;
+    }
+
+    std::fill(Changed.begin(), Changed.end(), uint8_t(0));
+    Dirty = false;
+}
+
+void TransformGraph::Sort()
+{
+    size_t count = Parents.size();
+
+    // order the slots by how deep they are, keeping the current order within a depth
+    std::vector<int> depths(count, -1);
+    for (size_t slot = 0; slot < count; slot++)
+    {
+        // walk up to the first slot with a known depth, then fill in the depths on the way back down
+        int top = int(slot);
+        int steps = 0;
+        while (depths[top] < 0 && Parents[top] != NoParent)
+        {
+            top = Parents[top];
+            steps++;
+        }
+
+        int depth = depths[top] < 0 ? 0 : depths[top];
+        depths[top] = depth;
+
+        for (int below = int(slot); below != top; below = Parents[below])
+            depths[below] = depth + steps--;
+    }
+
+    std::vector<int> order(count);
+    for (size_t slot = 0; slot < count; slot++)
+        order[slot] = int(slot);
+
+    std::stable_sort(order.begin(), order.end(), [&depths](int lhs, int rhs) { return depths[lhs] < depths[rhs]; });
+
+    std::vector<int> newSlots(count);
+    for (size_t slot = 0; slot < count; slot++)
+        newSlots[order[slot]] = int(slot);
+
+    std::vector<int> parents(count);
+    std::vector<Vector3> positions(count);
+    std::vector<Quaternion> orientations(count);
+    std::vector<Matrix> worldMatrices(count);
+    std::vector<uint8_t> changed(count);
+    std::vector<unsigned int> versions(count);
+    std::vector<int> nodes(count);
+
+    for (size_t slot = 0; slot < count; slot++)
+    {
+        int oldSlot = order[slot];
+        parents[slot] = Parents[oldSlot] == NoParent ? NoParent : newSlots[Parents[oldSlot]];
+        positions[slot] = Positions[oldSlot];
+        orientations[slot] = Orientations[oldSlot];
+        worldMatrices[slot] = WorldMatrices[oldSlot];
+        changed[slot] = Changed[oldSlot];
+        versions[slot] = Versions[oldSlot];
+        nodes[slot] = Nodes[oldSlot];
+        Slots[nodes[slot]] = int(slot);
+    }
+
+    Parents.swap(parents);
+    Positions.swap(positions);
+    Orientations.swap(orientations);
+    WorldMatrices.swap(worldMatrices);
+    Changed.swap(changed);
+    Versions.swap(versions);
+    Nodes.swap(nodes);
+
+    Sorted = true;
+}
@@ -0,0 +1,181 @@
+/*********************************************************************************************
+*
+*   raylib-extras, FPS collision example
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+#include "wall_packets.h"
+#include "raymath.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef COLLISION_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+void WallPackets::Build(const ObstacleGrid& grid, const std::vector<Matrix>& inverseMatrices, const std::vector<BoundingBox>& localBounds)
+{
+    Packets.clear();
+    CellStarts.assign(size_t(grid.GetCellCount()) + 1, 0);
+
+    for (int cell = 0; cell < grid.GetCellCount(); cell++)
+    {
+        int count = 0;
+        const int* items = grid.GetCellItems(cell, count);
+
+        for (int first = 0; first < count; first += PacketSize)
+        {
+            Packet packet;
+            for (int lane = 0; lane < PacketSize; lane++)
+            {
+                // short packets repeat their first wall, testing it twice can't change the nearest hit
+                int index = items[first + lane < count ? first + lane : first];
+                const Matrix& inverse = inverseMatrices[index];
+                const BoundingBox& bounds = localBounds[index];
+
+                float rows[12] = { inverse.m0, inverse.m4, inverse.m8, inverse.m12,
+                                   inverse.m1, inverse.m5, inverse.m9, inverse.m13,
+                                   inverse.m2, inverse.m6, inverse.m10, inverse.m14 };
+                for (int i = 0; i < 12; i++)
+                    packet.Inverse[i][lane] = rows[i];
+
+                packet.Min[0][lane] = bounds.min.x;
+                packet.Min[1][lane] = bounds.min.y;
+                packet.Min[2][lane] = bounds.min.z;
+                packet.Max[0][lane] = bounds.max.x;
+                packet.Max[1][lane] = bounds.max.y;
+                packet.Max[2][lane] = bounds.max.z;
+                packet.Index[lane] = index;
+            }
+            Packets.push_back(packet);
+        }
+
+        CellStarts[cell + 1] = int(Packets.size());
+    }
+}
+
+void WallPackets::TestPacket(const Packet& packet, const Vector3& origin, const Vector3& direction, float& nearest, int& nearestIndex) const
+{
+    // slab test the ray against each wall in its local space
+    // a ray that starts inside a wall hits where it leaves it, like GetRayCollisionBox does
+    alignas(16) float distances[PacketSize];
+    int hitMask = 0;
+
+#ifdef COLLISION_USE_SSE2
+    const __m128 originX = _mm_set1_ps(origin.x);
+    const __m128 originY = _mm_set1_ps(origin.y);
+    const __m128 originZ = _mm_set1_ps(origin.z);
+    const __m128 directionX = _mm_set1_ps(direction.x);
+    const __m128 directionY = _mm_set1_ps(direction.y);
+    const __m128 directionZ = _mm_set1_ps(direction.z);
+    const __m128 zero = _mm_setzero_ps();
+
+    __m128 near = _mm_set1_ps(-std::numeric_limits<float>::max());
+    __m128 far = _mm_set1_ps(std::numeric_limits<float>::max());
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        const float* row = packet.Inverse[axis * 4];
+        // summed in the same order as Vector3Transform so the lanes match the scalar test bit for bit
+        __m128 localOrigin = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(row), originX), _mm_mul_ps(_mm_load_ps(row + 4), originY)),
+                                                   _mm_mul_ps(_mm_load_ps(row + 8), originZ)), _mm_load_ps(row + 12));
+        __m128 localDirection = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(row), directionX), _mm_mul_ps(_mm_load_ps(row + 4), directionY)),
+                                           _mm_mul_ps(_mm_load_ps(row + 8), directionZ));
+        __m128 inverseDirection = _mm_div_ps(_mm_set1_ps(1.0f), localDirection);
+
+        __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(packet.Min[axis]), localOrigin), inverseDirection);
+        __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(packet.Max[axis]), localOrigin), inverseDirection);
+
+        near = _mm_max_ps(near, _mm_min_ps(t1, t2));
+        far = _mm_min_ps(far, _mm_max_ps(t1, t2));
+    }
+
+    __m128 hit = _mm_and_ps(_mm_cmpge_ps(far, zero), _mm_cmple_ps(near, far));
+    __m128 inside = _mm_cmplt_ps(near, zero);
+    __m128 distance = _mm_or_ps(_mm_and_ps(inside, far), _mm_andnot_ps(inside, near));
+
+    _mm_store_ps(distances, distance);
+    hitMask = _mm_movemask_ps(hit);
+#else
+    float originAxes[3] = { origin.x, origin.y, origin.z };
+    float directionAxes[3] = { direction.x, direction.y, direction.z };
+
+    for (int lane = 0; lane < PacketSize; lane++)
+    {
+        float near = -std::numeric_limits<float>::max();
+        float far = std::numeric_limits<float>::max();
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const float* row = packet.Inverse[axis * 4];
+            float localOrigin = row[lane] * originAxes[0] + row[4 + lane] * originAxes[1] + row[8 + lane] * originAxes[2] + row[12 + lane];
+            float localDirection = row[lane] * directionAxes[0] + row[4 + lane] * directionAxes[1] + row[8 + lane] * directionAxes[2];
+            float inverseDirection = 1.0f / localDirection;
+
+            float t1 = (packet.Min[axis][lane] - localOrigin) * inverseDirection;
+            float t2 = (packet.Max[axis][lane] - localOrigin) * inverseDirection;
+
+            near = std::max(near, std::min(t1, t2));
+            far = std::min(far, std::max(t1, t2));
+        }
+
+        if (far >= 0 && near <= far)
+            hitMask |= 1 << lane;
+        distances[lane] = near < 0 ? far : near;
+    }
+#endif
+
+    for (int lane = 0; lane < PacketSize; lane++)
+    {
+        if ((hitMask & (1 << lane)) && distances[lane] < nearest)
+        {
+            nearest = distances[lane];
+            nearestIndex = packet.Index[lane];
+        }
+    }
+}
+
+int WallPackets::CastRay(const ObstacleGrid& grid, const Ray& ray, float& distance) const
+{
+    int nearestIndex = -1;
+    float nearest = std::numeric_limits<float>::max();
+    float directionLength = Vector3Length(ray.direction);
+
+    ObstacleGrid::RayCursor cursor = grid.StartRay(ray);
+    int cell = 0;
+    while (grid.NextRayCell(cursor, cell))
+    {
+        for (int packet = CellStarts[cell]; packet < CellStarts[cell + 1]; packet++)
+            TestPacket(Packets[packet], ray.position, ray.direction, nearest, nearestIndex);
+
+        // nothing in a later cell can be closer than a hit before the ray left this one
+        if (nearestIndex >= 0 && nearest * directionLength <= cursor.ExitDistance)
+            break;
+    }
+
+    distance = nearest;
+    return nearestIndex;
+}
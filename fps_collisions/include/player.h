@@ -31,6 +31,25 @@
 #include "object_transform.h"
 #include "map.h"
 
+// what the player wants to do during a simulation tick
+// look deltas pile up over rendered frames until a tick uses them, so no mouse movement is lost
+struct PlayerInput
+{
+    float TurnDelta = 0;
+    float TiltDelta = 0;
+    Vector2 Movement = { 0 };
+    bool Fire = false;
+};
+
+// the parts of the player that are blended between ticks when drawing
+struct PlayerPose
+{
+    Vector3 Position = { 0 };
+    Quaternion Orientation = QuaternionIdentity();
+    float TiltAngle = 0;
+    Vector3 GunPosition = { 0 };
+};
+
 struct PlayerInfo
 {
     static constexpr float GunDefaultH = -0.25f;
@@ -63,12 +82,27 @@ struct PlayerInfo
 
     float Reload = 0;
 
+    // the pose before and after the last tick, the nodes are set between them for drawing
+    PlayerPose PreviousPose;
+    PlayerPose CurrentPose;
+
     static void SetupGraphics();
     static void CleanupGraphics();
 
     void Setup();
 
-    void Update(Map& map);
+    // add this frame's mouse and keyboard state to the input for the next tick
+    void ReadInput(PlayerInput& input);
+
+    // advance the player by one fixed simulation step
+    void Update(Map& map, const PlayerInput& input, float deltaTime);
+
+    // place the nodes and camera part way from the previous tick to the current one
+    void UpdateView(float alpha);
 
     void Draw();
+
+private:
+    PlayerPose GetPose();
+    void SetPose(const PlayerPose& pose);
 };
\ No newline at end of file
@@ -34,9 +34,23 @@
 #include "object_transform.h"
 #include "player.h"
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
 // global player
 PlayerInfo Player;
 
+// the simulation always steps by the same amount of time, no matter how fast frames are drawn
+constexpr float SimulationRate = 60.0f;
+constexpr float SimulationStep = 1.0f / SimulationRate;
+
+// if frames take too long, drop the extra time instead of trying to catch up forever
+constexpr int MaxStepsPerFrame = 8;
+
+float SimulationTime = 0;
+PlayerInput PendingInput;
+
 RenderTexture OverlayTexture = { 0 };
 
 void GameInit(Map &map)
@@ -52,6 +66,8 @@ void GameInit(Map &map)
     BuildDemoMap(map);
 
     map.Setup();
+    BuildDemoLevel(map);
+
     Player.Setup();
 }
 
@@ -63,9 +79,38 @@ void GameCleanup(Map& map)
     HUD::CleanupGraphics();
 }
 
+void GameStep(Map& map, const PlayerInput& input)
+{
+    Player.Update(map, input, SimulationStep);
+    map.Update(SimulationStep);
+}
+
 bool GameUpdate(Map& map)
 {
-    Player.Update(map);
+    Player.ReadInput(PendingInput);
+
+    SimulationTime += GetFrameTime();
+
+    int steps = 0;
+    while (SimulationTime >= SimulationStep)
+    {
+        if (steps == MaxStepsPerFrame)
+        {
+            SimulationTime = 0;
+            break;
+        }
+
+        GameStep(map, PendingInput);
+        SimulationTime -= SimulationStep;
+        steps++;
+
+        // the look deltas and the shot were used up by this step, movement carries on until the next frame reads input
+        PendingInput.TurnDelta = PendingInput.TiltDelta = 0;
+        PendingInput.Fire = false;
+    }
+
+    // draw the player part way between the last two steps, by how much time is left over
+    Player.UpdateView(SimulationTime / SimulationStep);
 
     return true;
 }
@@ -104,8 +149,53 @@ void GameDraw(Map& map)
     EndDrawing();
 }
 
-int main()
+// run the simulation as fast as it can go without a window, graphics or sound
+// a simple bot walks in circles and shoots, so player movement and ray casts get exercised
+int RunHeadless(Map& map, int steps)
 {
+    BuildDemoMap(map);
+    Player.Setup();
+
+    PlayerInput botInput;
+    botInput.Movement.y = 1;
+    botInput.Fire = true;
+
+    auto start = std::chrono::steady_clock::now();
+
+    int hitSteps = 0;
+    for (int i = 0; i < steps; i++)
+    {
+        // turn a little every step and strafe back and forth now and then
+        botInput.TurnDelta = 1.5f;
+        botInput.Movement.x = ((i / 120) % 3) - 1.0f;
+
+        GameStep(map, botInput);
+
+        if (Player.HitLastFrame)
+            hitSteps++;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Vector3 position = Player.PlayerNode.GetPosition();
+    printf("%d steps (%.1f simulated seconds) in %.3f seconds, %.0f steps per second\n", steps, steps * SimulationStep, seconds, steps / seconds);
+    printf("player ended at (%.3f, %.3f, %.3f), touched a wall on %d steps\n", position.x, position.y, position.z, hitSteps);
+
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    // --headless <steps> runs that many simulation steps without opening a window
+    for (int i = 1; i < argc; i++)
+    {
+        if (TextIsEqual(argv[i], "--headless") && i + 1 < argc)
+        {
+            Map map;
+            return RunHeadless(map, atoi(argv[i + 1]));
+        }
+    }
+
     SetConfigFlags(FLAG_VSYNC_HINT | FLAG_WINDOW_RESIZABLE);
     InitWindow(1280, 800, "FPS Collisions");
     SetTargetFPS(144);
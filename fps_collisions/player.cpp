@@ -66,59 +66,78 @@ void PlayerInfo::Setup()
     ViewCamera.position.y = 2;
     ViewCamera.position.z = -5;
 
+    CurrentPose = GetPose();
+    PreviousPose = CurrentPose;
+
 #ifndef _DEBUG
-    DisableCursor();
+    // there is no cursor to capture when the simulation runs without a window
+    if (IsWindowReady())
+        DisableCursor();
 #endif // _DEBUG
 }
 
-void PlayerInfo::Update(Map& map)
+void PlayerInfo::ReadInput(PlayerInput& input)
 {
-    DesiredMovement.x = DesiredMovement.y = DesiredMovement.z = 0;
+    input.Movement = Vector2{ 0, 0 };
+    // a click is kept until a tick uses it, so a short one between ticks still fires
+    input.Fire |= IsMouseButtonDown(MOUSE_LEFT_BUTTON);
 
 #ifdef _DEBUG
     if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT))
 #endif
     {
         constexpr float mouseSpeedScale = 0.5f;
-        constexpr float maxViewAngle = 89.95f;
-        constexpr float forwardSpeed = 30;
-        constexpr float sideSpeed = 10;
-
-        // rotate the player by the horizontal delta
-        PlayerNode.RotateV(-GetMouseDelta().x * mouseSpeedScale);
 
-        // rotate the camera node (head) by the tilt angle (clamped)
-        TitltAngle += -GetMouseDelta().y * mouseSpeedScale;
-        if (TitltAngle > maxViewAngle)
-            TitltAngle = maxViewAngle;
-        else if (TitltAngle < -maxViewAngle)
-            TitltAngle = -maxViewAngle;
-
-        CameraNode.SetOrientation(Vector3{ TitltAngle,0,0 });
-        ShoulderNode.SetOrientation(Vector3{ TitltAngle,0,0 });
+        // keep adding up the mouse movement until a tick uses it
+        input.TurnDelta += GetMouseDelta().x * mouseSpeedScale;
+        input.TiltDelta += GetMouseDelta().y * mouseSpeedScale;
 
         // get the input movement
-        Vector2 wadsVector = { 0 };
-
         if (IsKeyDown(KEY_W))
-            wadsVector.y += 1;
+            input.Movement.y += 1;
         if (IsKeyDown(KEY_S))
-            wadsVector.y -= 1;
+            input.Movement.y -= 1;
 
         if (IsKeyDown(KEY_A))
-            wadsVector.x += 1;
+            input.Movement.x += 1;
         if (IsKeyDown(KEY_D))
-            wadsVector.x -= 1;
-
-        // handle forward and sidestep motion
-        DesiredMovement = Vector3Add(DesiredMovement, Vector3Scale(PlayerNode.GetDVector(), forwardSpeed * wadsVector.y * GetFrameTime()));
-        DesiredMovement = Vector3Add(DesiredMovement, Vector3Scale(PlayerNode.GetHNegVector(), sideSpeed * wadsVector.x * GetFrameTime()));
+            input.Movement.x -= 1;
     }
+}
+
+void PlayerInfo::Update(Map& map, const PlayerInput& input, float deltaTime)
+{
+    constexpr float maxViewAngle = 89.95f;
+    constexpr float forwardSpeed = 30;
+    constexpr float sideSpeed = 10;
+
+    // drawing leaves the nodes between ticks, so start from where the last tick ended
+    SetPose(CurrentPose);
+    PreviousPose = CurrentPose;
+
+    DesiredMovement.x = DesiredMovement.y = DesiredMovement.z = 0;
+
+    // rotate the player by the horizontal delta
+    PlayerNode.RotateV(-input.TurnDelta);
+
+    // rotate the camera node (head) by the tilt angle (clamped)
+    TitltAngle += -input.TiltDelta;
+    if (TitltAngle > maxViewAngle)
+        TitltAngle = maxViewAngle;
+    else if (TitltAngle < -maxViewAngle)
+        TitltAngle = -maxViewAngle;
+
+    CameraNode.SetOrientation(Vector3{ TitltAngle,0,0 });
+    ShoulderNode.SetOrientation(Vector3{ TitltAngle,0,0 });
+
+    // handle forward and sidestep motion
+    DesiredMovement = Vector3Add(DesiredMovement, Vector3Scale(PlayerNode.GetDVector(), forwardSpeed * input.Movement.y * deltaTime));
+    DesiredMovement = Vector3Add(DesiredMovement, Vector3Scale(PlayerNode.GetHNegVector(), sideSpeed * input.Movement.x * deltaTime));
 
     // if we are moving, bobble the gun a little
     if (Vector3LengthSqr(DesiredMovement) > 0)
     {
-        BobbleTime += GetFrameTime();
+        BobbleTime += deltaTime;
         GunNode.SeteH(GunDefaultH + sinf(BobbleTime * 4.0f) * 0.05f);
         GunNode.SetV(GunDefaultV + cosf(BobbleTime * 6.0f) * 0.02f);
     }
@@ -127,26 +146,23 @@ void PlayerInfo::Update(Map& map)
     Vector3 oldPos = PlayerNode.GetPosition();
     Vector3 newWorldPos = Vector3Add(oldPos, DesiredMovement);
 
-    HitLastFrame = map.CollidePlayer(newWorldPos, oldPos, CollisionRadius, 2);
+    HitLastFrame = map.MovePlayer(newWorldPos, oldPos, CollisionRadius, 2);
 
     // set the player to where they can be
     PlayerNode.SetPosition(newWorldPos);
 
-    // update the camera with the new view.
-    CameraNode.SetCamera(ViewCamera);
-
     // raycast from the view into the world to see what it would hit
     Ray gunRay = { 0 };
-    gunRay.position = Vector3Transform(Vector3Zero(), CameraNode.GetWorldMatrix());
-    gunRay.direction = Vector3Subtract(Vector3Transform(Vector3{ 0,0,1 }, CameraNode.GetWorldMatrix()), gunRay.position);
+    gunRay.position = CameraNode.GetWorldPosition();
+    gunRay.direction = CameraNode.GetWorldDVector();
 
-    map.CollideRay(gunRay, LastGunCollision);   // optional, if you need to know what you hit, you can pass a pointer in here that will be set with the wall that is hit
+    map.CollideRay(gunRay, LastGunCollision);   // optional, if you need to know what you hit, you can pass the address of an Obstacle pointer in here that will be set to the wall that is hit
 
     // handle shooting
-    Reload -= GetFrameTime();  // decrement reload wait time
+    Reload -= deltaTime;  // decrement reload wait time
 
     // if we can shoot, and they want to shoot
-    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON) && Reload <= 0)
+    if (input.Fire && Reload <= 0)
     {
         // make them wait for another shot
         Reload = ReloadTime;
@@ -165,6 +181,41 @@ void PlayerInfo::Update(Map& map)
         param = Reload / ReloadTime;
 
     GunNode.SetD(param * RecoilDistance + GunDefaultD);
+
+    CurrentPose = GetPose();
+}
+
+void PlayerInfo::UpdateView(float alpha)
+{
+    PlayerPose pose;
+    pose.Position = Vector3Lerp(PreviousPose.Position, CurrentPose.Position, alpha);
+    pose.Orientation = QuaternionSlerp(PreviousPose.Orientation, CurrentPose.Orientation, alpha);
+    pose.TiltAngle = Lerp(PreviousPose.TiltAngle, CurrentPose.TiltAngle, alpha);
+    pose.GunPosition = Vector3Lerp(PreviousPose.GunPosition, CurrentPose.GunPosition, alpha);
+
+    SetPose(pose);
+
+    // update the camera with the new view.
+    CameraNode.SetCamera(ViewCamera);
+}
+
+PlayerPose PlayerInfo::GetPose()
+{
+    PlayerPose pose;
+    pose.Position = PlayerNode.GetPosition();
+    pose.Orientation = PlayerNode.GetOrientation();
+    pose.TiltAngle = TitltAngle;
+    pose.GunPosition = GunNode.GetPosition();
+    return pose;
+}
+
+void PlayerInfo::SetPose(const PlayerPose& pose)
+{
+    PlayerNode.SetPosition(pose.Position);
+    PlayerNode.SetOrientation(pose.Orientation);
+    CameraNode.SetOrientation(Vector3{ pose.TiltAngle,0,0 });
+    ShoulderNode.SetOrientation(Vector3{ pose.TiltAngle,0,0 });
+    GunNode.SetPosition(pose.GunPosition);
 }
 
 void PlayerInfo::Draw()
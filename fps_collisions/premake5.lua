@@ -1,4 +1,11 @@
-
 baseName = path.getbasename(os.getcwd())
 
-defineWorkspace(baseName)
\ No newline at end of file
+defineWorkspace(baseName)
+defineCollisionLibProject()
+defineCollisionTestProjects()
+
+project (baseName)
+    link_to("collision_lib")
+
+    -- the library needs raylib, so let the linker search both in any order
+    linkgroups "On"
\ No newline at end of file
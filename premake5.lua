@@ -27,7 +27,7 @@ end
 
 function link_to(lib)
     links (lib)
-    includedirs ("../"..lib,"../"..lib.."/include" )
+    includedirs {"../"..lib, "../"..lib.."/include"}
 end
 
 function download_progress(total, current)
@@ -119,6 +119,7 @@ function defineWorkspace(baseName)
 end
 
 include ("raylib_premake5.lua")
+include ("collision_lib/collision_lib.lua")
 cdialect "C99"
 cppdialect "C++17"
 check_raylib()
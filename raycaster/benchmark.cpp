@@ -0,0 +1,452 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "benchmark.h"
+
+#include "map.h"
+#include "objects.h"
+#include "raycast.h"
+#include "raycast_view.h"
+
+#include "raymath.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// how many objects are placed on each map, so the sprite code is part of the frame time
+constexpr int BenchmarkObjects = 500;
+
+// how many frames along the path are checked against the golden images
+constexpr int GoldenFrames = 4;
+
+// a map to run the camera path on
+struct BenchmarkMap
+{
+	const char* Name;
+	void (*Build)();
+};
+
+// a big map of scattered pillars, rays go a long way before they hit something
+static void BuildOpenMap()
+{
+	constexpr int32_t size = 1024;
+	CreateMap(size, size);
+
+	SetRandomSeed(1234);
+	for (int32_t y = 0; y < size; y++)
+	{
+		for (int32_t x = 0; x < size; x++)
+		{
+			if (x == 0 || y == 0 || x == size - 1 || y == size - 1 || GetRandomValue(0, 199) == 0)
+				MapData[GetMapIndex(x, y)] = uint8_t(GetRandomValue(1, 8));
+		}
+	}
+
+	UpdateMapDistances();
+}
+
+// a big dense map with doors, thin walls and short walls mixed in, rays are short and the special cells are common
+static void BuildDenseMap()
+{
+	constexpr int32_t size = 1024;
+	CreateMap(size, size);
+
+	SetRandomSeed(5678);
+	for (int32_t y = 0; y < size; y++)
+	{
+		for (int32_t x = 0; x < size; x++)
+		{
+			size_t index = GetMapIndex(x, y);
+			bool edge = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+
+			if (!edge && GetRandomValue(0, 7) != 0)
+				continue;
+
+			MapData[index] = uint8_t(GetRandomValue(1, 8));
+			if (edge)
+				continue;
+
+			switch (GetRandomValue(0, 5))
+			{
+			case 0:
+				MapFlags[index] = CellFlagDoor;
+				MapDoorOpen[index] = uint8_t(GetRandomValue(0, 255));
+				break;
+
+			case 1:
+				MapFlags[index] = CellFlagThinWall | CellFlagAlongX;
+				break;
+
+			case 2:
+				MapHeights[index] = uint8_t(GetRandomValue(32, 192));
+				break;
+			}
+		}
+	}
+
+	UpdateMapDistances();
+}
+
+// find an open cell near the middle of the map to start the camera path at
+static Vector2 FindPathCenter()
+{
+	int32_t centerX = MapWidth / 2;
+	int32_t centerY = MapHeight / 2;
+
+	for (int32_t radius = 0; radius < std::max(MapWidth, MapHeight); radius++)
+	{
+		for (int32_t y = centerY - radius; y <= centerY + radius; y++)
+		{
+			for (int32_t x = centerX - radius; x <= centerX + radius; x++)
+			{
+				if (IsInMap(x, y) && GetMapGrid(x, y) == 0)
+					return Vector2{ x + 0.5f, y + 0.5f };
+			}
+		}
+	}
+
+	return Vector2{ MapWidth * 0.5f, MapHeight * 0.5f };
+}
+
+// the camera turns a full circle while it moves around a small loop, staying where it is if the loop goes into a wall
+static RaycastCamera GetPathCamera(const Vector2& center, int frame, int frameCount)
+{
+	float angle = frame * (2 * PI / frameCount);
+
+	RaycastCamera camera;
+	camera.Position = Vector2Add(center, Vector2{ cosf(angle * 3) * 0.3f, sinf(angle * 3) * 0.3f });
+	if (GetMapGrid(camera.Position) != 0)
+		camera.Position = center;
+
+	camera.Facing = Vector2{ cosf(angle), sinf(angle) };
+	camera.Plane = Vector2{ 0.66f * sinf(angle), -0.66f * cosf(angle) };
+
+	return camera;
+}
+
+// scatter objects over the open cells of the map
+static void PlaceObjects(std::vector<MapObject>& objects)
+{
+	objects.clear();
+
+	SetRandomSeed(42);
+	for (int i = 0; i < BenchmarkObjects; i++)
+	{
+		Vector2 position = { float(GetRandomValue(0, MapWidth - 1)) + 0.5f, float(GetRandomValue(0, MapHeight - 1)) + 0.5f };
+		if (GetMapGrid(position) == 0)
+			objects.push_back(MapObject{ position, float(GetRandomValue(0, 359)) });
+	}
+}
+
+static double GetMilliseconds(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double GetPercentile(std::vector<double> values, double percentile)
+{
+	if (values.empty())
+		return 0;
+
+	std::sort(values.begin(), values.end());
+	return values[std::min(size_t(percentile * values.size()), values.size() - 1)];
+}
+
+// cast the rays of every frame of the path and return how long it took in milliseconds
+static double TimePathCasting(const Vector2& center, RaycastView& view, int frameCount)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for (int frame = 0; frame < frameCount; frame++)
+	{
+		view.Camera = GetPathCamera(center, frame, frameCount);
+		CastViewColumns(view.Camera, view.Columns, view.Rays.data(), 0, view.GetWidth());
+	}
+
+	return GetMilliseconds(start);
+}
+
+static void PrintCastResult(const char* name, double milliseconds, int frameCount, int viewWidth)
+{
+	double rays = double(frameCount) * viewWidth;
+	printf("  cast %-24s %8.3f ms/view %8.2f Mrays/s\n", name, milliseconds / frameCount, rays / (milliseconds * 1000.0));
+}
+
+static size_t CountDifferentPixels(const Color* a, const Color* b, size_t count)
+{
+	size_t different = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (a[i].r != b[i].r || a[i].g != b[i].g || a[i].b != b[i].b || a[i].a != b[i].a)
+			different++;
+	}
+
+	return different;
+}
+
+// draw a view the slow way to check the fast one against, every ray is cast on it's own with CastRay and the whole frame is drawn on this thread
+static void DrawReferenceView(RaycastView& view, const std::vector<MapObject>& objects, const ObjectGrid& grid, int spriteFrames, const SoftwareScene& scene)
+{
+	const float* cameraX = view.Columns.CameraX.data();
+
+	for (int i = 0; i < view.GetWidth(); i++)
+	{
+		RayResult& ray = view.Rays[i];
+		ray.Directon.x = view.Camera.Facing.x + view.Camera.Plane.x * cameraX[i];
+		ray.Directon.y = view.Camera.Facing.y + view.Camera.Plane.y * cameraX[i];
+
+		CastRay(view.Camera.Position, ray);
+	}
+
+	view.Objects.Update(objects, grid, view.Camera, view.Rays.data(), view.GetWidth(), view.GetHeight(), spriteFrames);
+
+	SoftwareScene viewScene = scene;
+	viewScene.Objects = view.Objects.Spans.data();
+	viewScene.ObjectCount = view.Objects.Spans.size();
+
+	DrawViewColumns(view.Frame, view.WallColumns, view.Camera, viewScene, view.Rays.data(), 0, view.GetWidth());
+}
+
+// save a golden image, returns false if it could not be written
+static bool SaveGoldenFrame(const BenchmarkOptions& options, const FrameBuffer& frame, const char* fileName)
+{
+	if (!DirectoryExists(options.GoldenFolder))
+		MakeDirectory(options.GoldenFolder);
+
+	if (!ExportFrameBuffer(frame, fileName))
+	{
+		printf("  golden %s could not be saved\n", fileName);
+		return false;
+	}
+
+	return true;
+}
+
+// compare a frame to it's golden image, or save it as the golden image
+// a missing golden image is saved from the reference frame, drawn with single rays on one thread
+// returns false if the frame does not match
+static bool CheckGoldenFrame(const BenchmarkOptions& options, const FrameBuffer& frame, const FrameBuffer& reference, const char* mapName, int frameIndex)
+{
+	const char* fileName = TextFormat("%s/%s_%d_%s.png", options.GoldenFolder, mapName, frameIndex, UseFixedPointDDA ? "fixed" : "float");
+
+	if (options.SaveGolden)
+		return SaveGoldenFrame(options, frame, fileName);
+
+	if (!FileExists(fileName))
+	{
+		printf("  golden %s is missing, saving it from the reference frame\n", fileName);
+		return SaveGoldenFrame(options, reference, fileName);
+	}
+
+	Image golden = LoadImage(fileName);
+	if (golden.data == nullptr)
+	{
+		printf("  golden %s could not be loaded\n", fileName);
+		return false;
+	}
+
+	bool match = golden.width == frame.Width && golden.height == frame.Height;
+	size_t different = 0;
+
+	if (match)
+	{
+		Color* colors = LoadImageColors(golden);
+		different = CountDifferentPixels(colors, frame.Pixels.data(), frame.Pixels.size());
+		UnloadImageColors(colors);
+	}
+
+	UnloadImage(golden);
+
+	if (!match || different > 0)
+	{
+		printf("  golden %s does not match (%zu pixels are different)\n", fileName, different);
+		return false;
+	}
+
+	return true;
+}
+
+// run the camera path on the current map, returns the number of frames that failed a check
+static int RunMapBenchmark(const BenchmarkOptions& options, ThreadPool& workers, const char* mapName)
+{
+	int failures = 0;
+
+	Vector2 center = FindPathCenter();
+
+	std::vector<MapObject> objects;
+	PlaceObjects(objects);
+
+	ObjectGrid grid;
+	grid.Build(objects);
+
+	std::vector<RaycastView> views(1);
+	RaycastView& view = views[0];
+	view.Resize(options.ViewWidth, options.ViewHeight);
+
+	RaycastView reference;
+	reference.Resize(options.ViewWidth, options.ViewHeight);
+
+	SoftwareScene scene;
+	scene.Walls = options.Walls;
+	scene.Sprite = options.Sprite;
+	scene.FloorTexture = options.FloorTexture;
+	scene.CeilingTexture = options.CeilingTexture;
+
+	int spriteFrames = options.Sprite != nullptr && options.Sprite->Height > 0 ? options.Sprite->Width / options.Sprite->Height : 0;
+
+	printf("%s: %d x %d map, %d frames of %d x %d from (%.1f, %.1f), %d objects, %d threads\n", mapName, MapWidth, MapHeight, options.Frames,
+		options.ViewWidth, options.ViewHeight, center.x, center.y, int(objects.size()), int(workers.GetThreadCount()));
+
+	// the whole frame, like the demo does it
+	std::vector<double> frameTimes;
+	frameTimes.reserve(options.Frames);
+
+	int goldenStep = std::max(options.Frames / GoldenFrames, 1);
+
+	for (int frame = 0; frame < options.Frames; frame++)
+	{
+		view.Camera = GetPathCamera(center, frame, options.Frames);
+
+		auto start = std::chrono::steady_clock::now();
+
+		CastViews(views, workers);
+		FindViewObjects(views, objects, grid, spriteFrames, workers);
+		DrawViews(views, scene, workers);
+
+		frameTimes.push_back(GetMilliseconds(start));
+
+		if (frame % goldenStep != 0)
+			continue;
+
+		// casting in packets and drawing on the thread pool must give the same image as single rays on one thread
+		reference.Camera = view.Camera;
+		DrawReferenceView(reference, objects, grid, spriteFrames, scene);
+
+		size_t different = CountDifferentPixels(reference.Frame.Pixels.data(), view.Frame.Pixels.data(), view.Frame.Pixels.size());
+		if (different > 0)
+		{
+			printf("  frame %d is different from single rays drawn on one thread (%zu pixels)\n", frame, different);
+			failures++;
+			continue;
+		}
+
+		// skipping empty space must not change the image
+		FrameBuffer skipped = view.Frame;
+		SkipEmptySpace = !SkipEmptySpace;
+
+		CastViews(views, workers);
+		FindViewObjects(views, objects, grid, spriteFrames, workers);
+		DrawViews(views, scene, workers);
+
+		SkipEmptySpace = !SkipEmptySpace;
+
+		different = CountDifferentPixels(skipped.Pixels.data(), view.Frame.Pixels.data(), view.Frame.Pixels.size());
+		if (different > 0)
+		{
+			printf("  frame %d is different with empty space skipping on and off (%zu pixels)\n", frame, different);
+			failures++;
+		}
+		else if (options.GoldenFolder != nullptr && !CheckGoldenFrame(options, view.Frame, reference.Frame, mapName, frame / goldenStep))
+		{
+			failures++;
+		}
+	}
+
+	double totalTime = 0;
+	for (double time : frameTimes)
+		totalTime += time;
+
+	double columns = double(options.Frames) * options.ViewWidth;
+	printf("  frame %8.3f ms p50 %8.3f ms p95 %8.3f ms p99 %8.3f ms max %8.2f Mcolumns/s\n",
+		GetPercentile(frameTimes, 0.5), GetPercentile(frameTimes, 0.95), GetPercentile(frameTimes, 0.99), GetPercentile(frameTimes, 1.0),
+		columns / (totalTime * 1000.0));
+
+	// the ray casting on it's own, with each kind of ray math and with the special cells turned into plain blocks
+	// warm up the caches so the first run isn't penalized
+	TimePathCasting(center, view, options.Frames);
+
+	double mapTime = TimePathCasting(center, view, options.Frames);
+
+	bool useFixedPoint = UseFixedPointDDA;
+	UseFixedPointDDA = !useFixedPoint;
+	double otherMathTime = TimePathCasting(center, view, options.Frames);
+	UseFixedPointDDA = useFixedPoint;
+
+	size_t cellCount = size_t(MapWidth) * size_t(MapHeight);
+	std::vector<uint8_t> flags(MapFlags, MapFlags + cellCount);
+	std::vector<uint8_t> heights(MapHeights, MapHeights + cellCount);
+
+	memset(MapFlags, CellFlagNone, cellCount);
+	memset(MapHeights, FullWallHeight, cellCount);
+
+	double plainTime = TimePathCasting(center, view, options.Frames);
+
+	memcpy(MapFlags, flags.data(), cellCount);
+	memcpy(MapHeights, heights.data(), cellCount);
+
+	PrintCastResult(useFixedPoint ? "16.16 fixed point" : "float", mapTime, options.Frames, options.ViewWidth);
+	PrintCastResult(useFixedPoint ? "float" : "16.16 fixed point", otherMathTime, options.Frames, options.ViewWidth);
+	PrintCastResult("plain cells", plainTime, options.Frames, options.ViewWidth);
+
+	return failures;
+}
+
+int RunRaycastBenchmark(const BenchmarkOptions& options, ThreadPool& workers)
+{
+	static const BenchmarkMap generatedMaps[] =
+	{
+		{ "open", BuildOpenMap },
+		{ "dense", BuildDenseMap },
+	};
+
+	// the map that was loaded goes first, then the generated ones
+	int failures = RunMapBenchmark(options, workers, "current");
+
+	for (const BenchmarkMap& map : generatedMaps)
+	{
+		map.Build();
+		failures += RunMapBenchmark(options, workers, map.Name);
+	}
+
+	if (options.GoldenFolder != nullptr)
+	{
+		if (options.SaveGolden)
+			printf("golden images saved to %s\n", options.GoldenFolder);
+		else if (failures == 0)
+			printf("every frame matches the golden images\n");
+	}
+
+	if (failures > 0)
+		printf("%d frames failed\n", failures);
+
+	return failures;
+}
@@ -0,0 +1,64 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#pragma once
+
+#include "raylib.h"
+#include "software_renderer.h"
+#include "thread_pool.h"
+
+// what the benchmark runs and how it checks the images it draws
+struct BenchmarkOptions
+{
+	int ViewWidth = 1024;
+	int ViewHeight = 768;
+
+	// how many frames the camera path is split into on each map
+	int Frames = 360;
+
+	// a folder of golden images, a few frames of each map are compared to them, or saved to them when SaveGolden is set
+	// a golden image that is missing is saved from the single ray reference draw, so the next run checks against it
+	const char* GoldenFolder = "resources/golden";
+	bool SaveGolden = false;
+
+	// the textures to draw with, walls are flat shaded and objects are not drawn without them
+	const SoftwareTexture* Walls = nullptr;
+	const SoftwareTexture* Sprite = nullptr;
+	int FloorTexture = -1;
+	int CeilingTexture = -1;
+};
+
+// Run scripted camera paths over the current map and a few generated maps without a window.
+// For each map this reports the rays and columns per second and frame time percentiles for the whole frame
+// (cast, objects and software draw), and times the ray casting alone with float math, fixed point math and with
+// every wall as a plain full height block, to see what doors, thin walls and short walls cost.
+// A few frames of each map are checked against a draw with single rays on one thread, and against the golden images.
+// Returns the number of frames that did not match, 0 when every check passed.
+// The current map is replaced by the generated maps.
+int RunRaycastBenchmark(const BenchmarkOptions& options, ThreadPool& workers);
@@ -0,0 +1,164 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "raylib.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// flags for a map cell
+enum MapCellFlags : uint8_t
+{
+	CellFlagNone = 0,
+
+	// the cell is a thin wall that slides open sideways, see MapDoorOpen
+	CellFlagDoor = 1 << 0,
+
+	// the wall is a thin plane through the middle of the cell instead of filling it
+	CellFlagThinWall = 1 << 1,
+
+	// thin walls and doors run along the X axis (across the cell in Y), otherwise they run along the Y axis
+	CellFlagAlongX = 1 << 2,
+};
+
+// a wall height for cells that fill the whole height of the view
+constexpr uint8_t FullWallHeight = 255;
+
+// how big the map is world space
+extern int32_t MapWidth;
+extern int32_t MapHeight;
+
+// the map cells are stored as separate planes, one byte per cell in each plane
+// the ray caster only walks the wall types, so the other data does not take up cache space while casting
+
+// the wall type for each cell, 0 is empty, anything else is a texture index + 1
+extern uint8_t* MapData;
+
+// the MapCellFlags for each cell
+extern uint8_t* MapFlags;
+
+// the wall height for each cell, FullWallHeight is as tall as a normal wall
+extern uint8_t* MapHeights;
+
+// how far open each door is, 0 is closed and 255 is all the way open. This is game state and is not saved
+extern uint8_t* MapDoorOpen;
+
+// the Chebyshev distance from each cell to the nearest wall or the edge of the map, 0 for walls
+// every cell that has a wall type counts as a wall, including doors, thin walls and short walls
+// the ray caster uses this to jump over empty space, a ray in a cell with a distance of D can move D - 1 cells on
+// each axis without touching a wall. This is built from the wall types when the map changes and is not saved
+extern uint8_t* MapDistance;
+
+// the largest distance stored, larger values save little and make updating a changed cell slower
+constexpr uint8_t MaxMapDistance = 16;
+
+// the header of a binary map file
+// the planes follow the header in the file, so the file can be used in memory as is without parsing each cell
+struct MapFileHeader
+{
+	char Magic[4];				// "RCMP"
+	uint32_t Version;
+	int32_t Width;
+	int32_t Height;
+	uint64_t WallTypeOffset;	// offsets to each plane from the start of the file, each plane is Width * Height bytes
+	uint64_t FlagsOffset;
+	uint64_t HeightOffset;
+};
+
+constexpr uint32_t MapFileVersion = 1;
+
+// set the map to the built in 24x24 map
+void LoadDefaultMap();
+
+// create an empty map of the given size, everything is open space
+bool CreateMap(int32_t width, int32_t height);
+
+// load a binary map file, the current map is kept if the file is not valid
+bool LoadMap(const char* fileName);
+
+// save the current map as a binary map file
+bool SaveMap(const char* fileName);
+
+inline bool IsInMap(int32_t x, int32_t y)
+{
+	return x >= 0 && y >= 0 && x < MapWidth && y < MapHeight;
+}
+
+inline size_t GetMapIndex(int32_t x, int32_t y)
+{
+	return size_t(y) * size_t(MapWidth) + size_t(x);
+}
+
+// get the grid for map coordinate
+inline uint8_t GetMapGrid(int32_t x, int32_t y)
+{
+	if (!IsInMap(x, y))
+		return 0;
+
+	return MapData[GetMapIndex(x, y)];
+}
+
+inline uint8_t GetMapGrid(const Vector2& pos)
+{
+	return GetMapGrid(int32_t(floorf(pos.x)), int32_t(floorf(pos.y)));
+}
+
+inline uint8_t GetMapFlags(int32_t x, int32_t y)
+{
+	if (!IsInMap(x, y))
+		return CellFlagNone;
+
+	return MapFlags[GetMapIndex(x, y)];
+}
+
+inline uint8_t GetMapHeight(int32_t x, int32_t y)
+{
+	if (!IsInMap(x, y))
+		return 0;
+
+	return MapHeights[GetMapIndex(x, y)];
+}
+
+// change a map cell, the distances around the cell are updated if it changed between a wall and open space
+void SetMapCell(int32_t x, int32_t y, uint8_t wallType, uint8_t flags = CellFlagNone, uint8_t height = FullWallHeight);
+
+// rebuild the distances for the whole map, call this after changing many cells in MapData directly
+void UpdateMapDistances();
+
+// a sprite that is placed in the map
+struct MapObject
+{
+	Vector2 Position;
+	float Facing = 0;
+
+	bool IsVissible = false;
+	float Distance = 0; // distance to the player, used to determine visibility
+};
@@ -0,0 +1,135 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#pragma once
+
+#include "raylib.h"
+#include "map.h"
+#include "raycast.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// where a visible object is drawn in the view
+struct ObjectSpan
+{
+	uint32_t Object = 0;		// index of the object
+
+	float Depth = 0;			// distance in front of the camera plane
+
+	// the sprite is a square of this size on screen, these are not clipped to the view
+	int Left = 0;
+	int Top = 0;
+	int Size = 0;
+
+	// the first and one past the last column where the object is in front of the walls
+	int StartColumn = 0;
+	int EndColumn = 0;
+
+	int Frame = 0;				// the sprite frame for the angle the object is seen from
+};
+
+// the objects are sorted into buckets that each cover a square of map cells
+// visibility only needs to look at the buckets that the view can see
+struct ObjectGrid
+{
+	// how many map cells each bucket covers on each side
+	static constexpr int32_t BucketSize = 8;
+
+	int32_t Width = 0;
+	int32_t Height = 0;
+
+	// the objects in each bucket are BucketObjects[BucketStart[i]] up to BucketObjects[BucketStart[i + 1]]
+	std::vector<uint32_t> BucketStart;
+	std::vector<uint32_t> BucketObjects;
+
+	// sort the objects into buckets, this is a counting sort so it is cheap to do every frame as objects move
+	void Build(const std::vector<MapObject>& objects);
+
+	// call a function for every object in the buckets that overlap an area of the map
+	template<class Func>
+	void ForEachInArea(float minX, float minY, float maxX, float maxY, Func&& func) const;
+
+	int32_t GetBucketX(float x) const;
+	int32_t GetBucketY(float y) const;
+};
+
+// the objects that are visible from a camera, in the order they are drawn
+// the order is kept from frame to frame, objects don't move much between frames so it only needs small fix ups
+struct VisibleObjects
+{
+	// the visible objects, far to near
+	std::vector<ObjectSpan> Spans;
+
+	// find the visible objects and where they go on screen
+	// objects that are behind the walls in every column they cover are not visible
+	// the objects are not changed, so several views can update from the same objects at once
+	void Update(const std::vector<MapObject>& objects, const ObjectGrid& grid, const RaycastCamera& camera, const RayResult* rays, int viewWidth, int viewHeight, int spriteFrames);
+
+private:
+	std::vector<ObjectSpan> Found;
+	std::vector<uint32_t> FoundSlot;
+	std::vector<uint32_t> FoundFrame;
+	uint32_t FrameNumber = 0;
+};
+
+inline int32_t ObjectGrid::GetBucketX(float x) const
+{
+	return std::min(std::max(int32_t(floorf(x)) / BucketSize, 0), Width - 1);
+}
+
+inline int32_t ObjectGrid::GetBucketY(float y) const
+{
+	return std::min(std::max(int32_t(floorf(y)) / BucketSize, 0), Height - 1);
+}
+
+template<class Func>
+inline void ObjectGrid::ForEachInArea(float minX, float minY, float maxX, float maxY, Func&& func) const
+{
+	if (Width == 0 || Height == 0)
+		return;
+
+	int32_t startX = GetBucketX(minX);
+	int32_t endX = GetBucketX(maxX);
+	int32_t startY = GetBucketY(minY);
+	int32_t endY = GetBucketY(maxY);
+
+	for (int32_t y = startY; y <= endY; y++)
+	{
+		for (int32_t x = startX; x <= endX; x++)
+		{
+			size_t bucket = size_t(y) * Width + x;
+
+			for (uint32_t i = BucketStart[bucket]; i < BucketStart[bucket + 1]; i++)
+				func(BucketObjects[i]);
+		}
+	}
+}
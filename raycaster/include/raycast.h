@@ -0,0 +1,121 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "raylib.h"
+
+#include <cstdint>
+#include <cstddef>
+
+// SSE2 is always present on x64, and is the default for 32 bit MSVC
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RAYCAST_USE_SSE2
+#endif
+
+// used to know what side of a grid was hit
+enum class HitNormals : uint8_t
+{
+	North = 0,
+	South,
+	East,
+	West
+};
+
+// a wall that is shorter than the view, a ray can see over it to what is behind
+struct RayLayer
+{
+	float Distance = 0;
+	float U = 0;
+	HitNormals Normal = HitNormals::North;
+	uint8_t HitGridType = 0;
+	uint8_t Height = 0;
+};
+
+// how many short walls a ray keeps track of, any more past these are not drawn
+constexpr uint8_t MaxRayLayers = 3;
+
+// a ray that has been cast, with cached info
+struct RayResult
+{
+	// the ray's direction
+	Vector2 Directon = { 0 };
+
+	// the distance to the cell hit
+	float Distance = 0;
+
+	// the side of the grid that was hit
+	HitNormals Normal;
+
+	// what kind of grid cell was hit
+	uint8_t HitGridType = 0;
+
+	// how far from the edge of the cell the hit is, for texturing
+	float U = 0;
+
+	// the short walls the ray passed over before the hit, nearest first
+	uint8_t LayerCount = 0;
+	RayLayer Layers[MaxRayLayers];
+};
+
+// the point of view that rays are cast from
+struct RaycastCamera
+{
+	Vector2 Position = { 0 };
+	Vector2 Facing = { 1, 0 };
+	Vector2 Plane = { 0, -0.66f };	// the 2d equivalent of a camera plane, rotates with the facing
+};
+
+// figure out how far from the edge of a cell a ray that was cast from the origin hit
+float GetRayU(const Vector2& origin, const RayResult& ray);
+
+// when set, rays jump over open areas using the map distances instead of stepping through every cell
+// the hits are the same either way
+extern bool SkipEmptySpace;
+
+// jumps shorter than this are not worth the extra math over just stepping
+constexpr uint8_t MinSkipDistance = 4;
+
+// when set, CastRay and CastRays walk the rays with 16.16 fixed point math instead of floats
+// the results are bit identical on every compiler and CPU, for things like lockstep replays, but are not the same as
+// the float results and are not cast in SIMD packets
+extern bool UseFixedPointDDA;
+
+// how many rays are walked together by the packet caster
+constexpr size_t RayPacketSize = 8;
+
+// cast a ray from the origin and find out what it hits
+void CastRay(const Vector2& origin, RayResult& ray);
+
+// cast a ray from the origin with the 16.16 fixed point DDA, no matter what UseFixedPointDDA is set to
+void CastRayFixed(const Vector2& origin, RayResult& ray);
+
+// cast a set of rays that all start at the same origin
+// rays are walked in packets of RayPacketSize using SIMD when it is available, with the remainder cast one at a time
+// the results are the same as calling CastRay on each ray
+void CastRays(const Vector2& origin, RayResult* rays, size_t count);
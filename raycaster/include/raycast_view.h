@@ -0,0 +1,76 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#pragma once
+
+#include "raylib.h"
+#include "map.h"
+#include "objects.h"
+#include "raycast.h"
+#include "software_renderer.h"
+#include "thread_pool.h"
+
+#include <vector>
+
+// one point of view into the map, like a player in split screen or a security camera
+// each view has it's own camera, rays, visible objects and frame buffer, the map and objects are shared
+struct RaycastView
+{
+	RaycastCamera Camera;
+
+	// the camera space offset of each column, and the rays that make up the view (one for each pixel in X)
+	ViewColumnTable Columns;
+	std::vector<RayResult> Rays;
+
+	// the objects that can be seen from the camera, found after the rays are cast
+	VisibleObjects Objects;
+
+	// the image the software renderer draws the view into, and the wall columns it finds along the way
+	FrameBuffer Frame;
+	ViewWallColumns WallColumns;
+
+	void Resize(int width, int height);
+
+	int GetWidth() const { return Frame.Width; }
+	int GetHeight() const { return Frame.Height; }
+};
+
+// how many columns of a view are cast or drawn by one task
+constexpr int ViewBandWidth = 64;
+
+// cast the rays for every view
+// every view is split into bands of columns, and the bands of all the views are spread over the workers together
+void CastViews(std::vector<RaycastView>& views, ThreadPool& workers);
+
+// find the objects each view can see, the rays need to be cast first. Each view is one task
+void FindViewObjects(std::vector<RaycastView>& views, const std::vector<MapObject>& objects, const ObjectGrid& grid, int spriteFrames, ThreadPool& workers);
+
+// draw every view into it's frame buffer with the software renderer, each view draws it's own visible objects
+// the bands of all the views are spread over the workers together, like CastViews
+void DrawViews(std::vector<RaycastView>& views, const SoftwareScene& scene, ThreadPool& workers);
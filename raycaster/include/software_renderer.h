@@ -0,0 +1,139 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "raylib.h"
+#include "map.h"
+#include "objects.h"
+#include "raycast.h"
+
+#include <vector>
+
+// a CPU side image the software renderer draws into, it is uploaded to a texture once per frame
+struct FrameBuffer
+{
+	int Width = 0;
+	int Height = 0;
+	std::vector<Color> Pixels;
+
+	void Resize(int width, int height);
+
+	Color* GetRow(int y) { return Pixels.data() + size_t(y) * Width; }
+};
+
+// a CPU side copy of a texture for the software renderer
+// the texels are stored a column at a time, so drawing a vertical strip of a wall or sprite reads memory in order
+struct SoftwareTexture
+{
+	int Width = 0;
+	int Height = 0;
+	std::vector<Color> Texels;
+
+	void Load(Image image);
+
+	const Color* GetColumn(int x) const { return Texels.data() + size_t(x) * Height; }
+};
+
+// the things the software renderer draws besides the map
+struct SoftwareScene
+{
+	// the wall textures, one square texture for each grid type, side by side. Walls are flat shaded without it
+	const SoftwareTexture* Walls = nullptr;
+
+	// the sprite frames, one square frame for each facing, side by side. Objects are not drawn without it
+	const SoftwareTexture* Sprite = nullptr;
+
+	// the textures from the wall set to use for the floor and ceiling, -1 for a flat color
+	int FloorTexture = -1;
+	int CeilingTexture = -1;
+
+	// the visible objects to draw, sorted back to front
+	const ObjectSpan* Objects = nullptr;
+	size_t ObjectCount = 0;
+
+	bool FlatShaded = false;
+};
+
+// the flat colors for the ceiling and floor
+constexpr Color CeilingColor = DARKGRAY;
+constexpr Color FloorColor = DARKBROWN;
+
+// the tint for each side of a grid, indexed by HitNormals
+extern const Color WallColors[4];
+
+// the camera space X of each view column, from -1 on the left edge to 1 on the right
+// the field of view is the length of the camera plane, so this only changes with the width of the view
+struct ViewColumnTable
+{
+	int Width = 0;
+	std::vector<float> CameraX;
+
+	// fill the table for a view width, this does nothing if it is already built for that width
+	void Build(int width);
+};
+
+// how a wall column maps to the screen and the wall texture
+struct WallColumn
+{
+	int Top = 0;
+	int Bottom = 0;
+
+	Color Tint = WHITE;
+
+	// the texture column to sample, or null for flat shaded
+	const Color* Texels = nullptr;
+
+	// the texture V at screen row 0 and how much it moves per row
+	float TexV = 0;
+	float TexStep = 0;
+};
+
+// the wall columns found for each view column before the rows are filled, kept with the view so they are not allocated every frame
+// a range of view columns only uses its own part, so separate ranges can still be drawn on different threads
+struct ViewWallColumns
+{
+	std::vector<WallColumn> Walls;
+
+	// the short walls each column sees over, MaxRayLayers per view column
+	std::vector<WallColumn> Layers;
+	std::vector<uint8_t> LayerCounts;
+
+	void Resize(int width);
+};
+
+// compute the ray directions for a range of view columns and cast them
+void CastViewColumns(const RaycastCamera& camera, const ViewColumnTable& columns, RayResult* rays, int startColumn, int endColumn);
+
+// draw a range of view columns into the frame buffer using rays that have already been cast
+// this draws the ceiling, floor, walls and then the visible objects, using the rays as a depth buffer
+// only the pixels and wall columns for those view columns are written, so separate ranges can be drawn on different threads
+void DrawViewColumns(FrameBuffer& frame, ViewWallColumns& wallColumns, const RaycastCamera& camera, const SoftwareScene& scene, const RayResult* rays, int startColumn, int endColumn);
+
+// save a frame buffer to an image file, this does not need a window so it can be used to test the renderer
+bool ExportFrameBuffer(const FrameBuffer& frame, const char* fileName);
@@ -0,0 +1,346 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "map.h"
+
+#include <cstring>
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+int32_t MapWidth = 0;
+int32_t MapHeight = 0;
+
+uint8_t* MapData = nullptr;
+uint8_t* MapFlags = nullptr;
+uint8_t* MapHeights = nullptr;
+uint8_t* MapDoorOpen = nullptr;
+uint8_t* MapDistance = nullptr;
+
+static std::vector<uint8_t> MapDoorOpenData;
+static std::vector<uint8_t> MapDistanceData;
+
+// the map is kept in memory in the same layout as the file, so loading is one read and saving is one write
+static unsigned char* MapFileData = nullptr;
+static int MapFileSize = 0;
+
+// the packet ray caster uses 32 bit cell indexes
+constexpr int64_t MaxMapCells = INT32_MAX;
+
+// planes start on a cache line
+constexpr uint64_t MapPlaneAlignment = 64;
+
+static uint64_t AlignPlane(uint64_t offset)
+{
+	return (offset + MapPlaneAlignment - 1) & ~(MapPlaneAlignment - 1);
+}
+
+static bool IsValidMapSize(int32_t width, int32_t height)
+{
+	return width > 0 && height > 0 && int64_t(width) * int64_t(height) <= MaxMapCells;
+}
+
+// check that a map file is complete and use it as the current map
+static bool UseMapFile(unsigned char* data, int size)
+{
+	if (data == nullptr || size < int(sizeof(MapFileHeader)))
+		return false;
+
+	MapFileHeader header;
+	memcpy(&header, data, sizeof(MapFileHeader));
+
+	if (memcmp(header.Magic, "RCMP", 4) != 0 || header.Version != MapFileVersion || !IsValidMapSize(header.Width, header.Height))
+		return false;
+
+	uint64_t planeSize = uint64_t(header.Width) * uint64_t(header.Height);
+
+	for (uint64_t offset : { header.WallTypeOffset, header.FlagsOffset, header.HeightOffset })
+	{
+		if (offset < sizeof(MapFileHeader) || offset > uint64_t(size) || uint64_t(size) - offset < planeSize)
+			return false;
+	}
+
+	if (MapFileData != nullptr)
+		MemFree(MapFileData);
+
+	MapFileData = data;
+	MapFileSize = size;
+
+	MapWidth = header.Width;
+	MapHeight = header.Height;
+
+	MapData = data + header.WallTypeOffset;
+	MapFlags = data + header.FlagsOffset;
+	MapHeights = data + header.HeightOffset;
+
+	// every door starts closed
+	MapDoorOpenData.assign(size_t(MapWidth) * size_t(MapHeight), 0);
+	MapDoorOpen = MapDoorOpenData.data();
+
+	UpdateMapDistances();
+
+	return true;
+}
+
+// compute the distances for a window of the map
+// the result has a border of one cell around the window, so the passes can read every neighbor without bounds checks.
+// This is a two pass chamfer transform, using a weight of 1 for all 8 neighbors gives the exact Chebyshev distance.
+// Cells outside the map count as walls, cells outside the window but inside the map are assumed to be far away
+static void ComputeMapDistances(int32_t startX, int32_t startY, int32_t endX, int32_t endY, std::vector<uint8_t>& distances)
+{
+	int32_t stride = endX - startX + 2;
+	int32_t rows = endY - startY + 2;
+
+	distances.resize(size_t(stride) * size_t(rows));
+
+	// the border is walls where it is off the map, and far away where it is just outside the window
+	auto getBorder = [](int32_t mapX, int32_t mapY) -> uint8_t
+		{
+			return IsInMap(mapX, mapY) ? MaxMapDistance : 0;
+		};
+
+	for (int32_t y = 0; y < rows; y++)
+	{
+		uint8_t* row = distances.data() + size_t(y) * stride;
+		int32_t mapY = startY + y - 1;
+
+		row[0] = getBorder(startX - 1, mapY);
+		row[stride - 1] = getBorder(endX, mapY);
+
+		if (y == 0 || y == rows - 1)
+		{
+			for (int32_t x = 1; x < stride - 1; x++)
+				row[x] = getBorder(startX + x - 1, mapY);
+			continue;
+		}
+
+		const uint8_t* cells = MapData + GetMapIndex(startX, mapY);
+		for (int32_t x = 1; x < stride - 1; x++)
+			row[x] = cells[x - 1] == 0 ? MaxMapDistance : 0;
+	}
+
+	// walls stay at 0 since nothing is smaller, so the passes don't need to branch on them.
+	// Each pass takes the three neighbors in the row it came from first, that part has no dependency from one cell
+	// to the next, and then sweeps along the row for the neighbor beside it
+
+	// forward pass, take the distance from the neighbors above and to the left
+	for (int32_t y = 1; y < rows - 1; y++)
+	{
+		uint8_t* row = distances.data() + size_t(y) * stride;
+		const uint8_t* above = row - stride;
+
+		for (int32_t x = 1; x < stride - 1; x++)
+			row[x] = std::min<uint8_t>(row[x], std::min(std::min(above[x - 1], above[x]), above[x + 1]) + 1);
+
+		for (int32_t x = 1; x < stride - 1; x++)
+			row[x] = std::min<uint8_t>(row[x], row[x - 1] + 1);
+	}
+
+	// backward pass, take the distance from the neighbors below and to the right
+	for (int32_t y = rows - 2; y > 0; y--)
+	{
+		uint8_t* row = distances.data() + size_t(y) * stride;
+		const uint8_t* below = row + stride;
+
+		for (int32_t x = 1; x < stride - 1; x++)
+			row[x] = std::min<uint8_t>(row[x], std::min(std::min(below[x - 1], below[x]), below[x + 1]) + 1);
+
+		for (int32_t x = stride - 2; x > 0; x--)
+			row[x] = std::min<uint8_t>(row[x], row[x + 1] + 1);
+	}
+}
+
+// copy part of a computed window into the map distances
+static void StoreMapDistances(int32_t windowX, int32_t windowY, int32_t windowWidth, const std::vector<uint8_t>& distances, int32_t startX, int32_t startY, int32_t endX, int32_t endY)
+{
+	int32_t stride = windowWidth + 2;
+
+	for (int32_t y = startY; y < endY; y++)
+	{
+		const uint8_t* source = distances.data() + size_t(y - windowY + 1) * stride + (startX - windowX + 1);
+		memcpy(MapDistance + GetMapIndex(startX, y), source, size_t(endX - startX));
+	}
+}
+
+void UpdateMapDistances()
+{
+	MapDistanceData.resize(size_t(MapWidth) * size_t(MapHeight));
+	MapDistance = MapDistanceData.data();
+
+	std::vector<uint8_t> distances;
+	ComputeMapDistances(0, 0, MapWidth, MapHeight, distances);
+	StoreMapDistances(0, 0, MapWidth, distances, 0, 0, MapWidth, MapHeight);
+}
+
+// update the distances for the cells that a change to one cell can reach
+// only cells within MaxMapDistance of the change can have a different distance, and the walls that set their
+// distance are within MaxMapDistance of them, so a window twice that size has everything needed to compute them
+static void UpdateMapDistancesAround(int32_t cellX, int32_t cellY)
+{
+	constexpr int32_t reach = MaxMapDistance;
+
+	int32_t startX = std::max(cellX - reach * 2, 0);
+	int32_t startY = std::max(cellY - reach * 2, 0);
+	int32_t endX = std::min(cellX + reach * 2 + 1, MapWidth);
+	int32_t endY = std::min(cellY + reach * 2 + 1, MapHeight);
+
+	std::vector<uint8_t> window;
+	ComputeMapDistances(startX, startY, endX, endY, window);
+
+	StoreMapDistances(startX, startY, endX - startX, window, std::max(cellX - reach, 0), std::max(cellY - reach, 0), std::min(cellX + reach + 1, MapWidth), std::min(cellY + reach + 1, MapHeight));
+}
+
+bool CreateMap(int32_t width, int32_t height)
+{
+	if (!IsValidMapSize(width, height))
+		return false;
+
+	uint64_t planeSize = uint64_t(width) * uint64_t(height);
+
+	MapFileHeader header = { { 'R', 'C', 'M', 'P' }, MapFileVersion, width, height };
+	header.WallTypeOffset = AlignPlane(sizeof(MapFileHeader));
+	header.FlagsOffset = AlignPlane(header.WallTypeOffset + planeSize);
+	header.HeightOffset = AlignPlane(header.FlagsOffset + planeSize);
+
+	uint64_t fileSize = header.HeightOffset + planeSize;
+	if (fileSize > uint64_t(INT32_MAX))
+		return false;
+
+	unsigned char* data = (unsigned char*)MemAlloc((unsigned int)fileSize);
+	if (data == nullptr)
+		return false;
+
+	memcpy(data, &header, sizeof(MapFileHeader));
+	memset(data + header.HeightOffset, FullWallHeight, planeSize);
+
+	return UseMapFile(data, int(fileSize));
+}
+
+bool LoadMap(const char* fileName)
+{
+	int size = 0;
+	unsigned char* data = LoadFileData(fileName, &size);
+
+	if (UseMapFile(data, size))
+		return true;
+
+	TraceLog(LOG_WARNING, "MAP: [%s] is not a valid map file", fileName);
+
+	if (data != nullptr)
+		UnloadFileData(data);
+
+	return false;
+}
+
+bool SaveMap(const char* fileName)
+{
+	if (MapFileData == nullptr)
+		return false;
+
+	return SaveFileData(fileName, MapFileData, MapFileSize);
+}
+
+void SetMapCell(int32_t x, int32_t y, uint8_t wallType, uint8_t flags, uint8_t height)
+{
+	if (!IsInMap(x, y))
+		return;
+
+	size_t index = GetMapIndex(x, y);
+	bool wasOpen = MapData[index] == 0;
+
+	MapData[index] = wallType;
+	MapFlags[index] = flags;
+	MapHeights[index] = height;
+
+	if (wasOpen != (wallType == 0))
+		UpdateMapDistancesAround(x, y);
+}
+
+// the built in map
+static constexpr int32_t DefaultMapSize = 24;
+
+static const uint8_t DefaultMapData[DefaultMapSize * DefaultMapSize] = { 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 7, 7, 7, 7, 7, 7, 7, 7,
+						4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0 ,0, 0, 0, 0, 0, 7,
+						4, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7,
+						4, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7,
+						4, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 0, 0, 7,
+						4, 0, 4, 0, 0, 0, 0, 5, 5, 5, 5, 5, 5, 5, 5, 5, 7, 7, 0, 7, 7, 7, 7, 7,
+						4, 0, 5, 0, 0, 0, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 7, 0, 0, 0, 7, 7, 7, 1,
+						4, 0, 6, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 5, 7, 0, 0, 0, 0, 0, 0, 8,
+						4, 0, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 7, 7, 1,
+						4, 0, 8, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 5, 7, 0, 0, 0, 0, 0, 0, 8,
+						4, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 5, 7, 0, 0, 0, 7, 7, 7, 1,
+						4, 0, 0, 0, 0, 0, 0, 5, 5, 5, 5, 0, 5, 5, 5, 5, 7, 7, 7, 7, 7, 7, 7, 1,
+						6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 0, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+						8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4,
+						6, 6, 6, 6, 6, 6, 0, 6, 6, 6, 6, 0, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+						4, 4, 4, 4, 4, 4, 0, 4, 4, 4, 6, 0, 6, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3,
+						4, 0, 0, 0, 0, 0, 0, 0, 0, 4, 6, 0, 6, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 2,
+						4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6, 2, 0, 0, 5, 0, 0, 2, 0, 0, 0, 2,
+						4, 0, 0, 0, 0, 0, 0, 0, 0, 4, 6, 0, 6, 2, 0, 0, 0, 0, 0, 2, 2, 0, 2, 2,
+						4, 0, 6, 0, 6, 0, 0, 0, 0, 4, 6, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 2,
+						4, 0, 0, 5, 0, 0, 0, 0, 0, 4, 6, 0, 6, 2, 0, 0, 0, 0, 0, 2, 2, 0, 2, 2,
+						4, 0, 6, 0, 6, 0, 0, 0, 0, 4, 6, 0, 6, 2, 0, 0, 5, 0, 0, 2, 0, 0, 0, 2,
+						4, 0, 0, 0, 0, 0, 0, 0, 0, 4, 6, 0, 6, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 2,
+						4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 1, 1, 1, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3 };
+
+// the doors, thin walls and short walls in the built in map
+struct DefaultMapCell
+{
+	int32_t X;
+	int32_t Y;
+	uint8_t WallType;
+	uint8_t Flags;
+	uint8_t Height;
+};
+
+static const DefaultMapCell DefaultMapCells[] =
+{
+	{ 16, 2, 8, CellFlagDoor, FullWallHeight },
+	{ 16, 3, 8, CellFlagDoor, FullWallHeight },
+	{ 9, 2, 1, CellFlagNone, 96 },
+	{ 9, 3, 1, CellFlagNone, 96 },
+	{ 13, 1, 2, CellFlagThinWall, FullWallHeight },
+	{ 11, 11, 3, CellFlagThinWall | CellFlagAlongX, 160 },
+};
+
+void LoadDefaultMap()
+{
+	CreateMap(DefaultMapSize, DefaultMapSize);
+	memcpy(MapData, DefaultMapData, sizeof(DefaultMapData));
+
+	for (const DefaultMapCell& cell : DefaultMapCells)
+	{
+		size_t index = GetMapIndex(cell.X, cell.Y);
+		MapData[index] = cell.WallType;
+		MapFlags[index] = cell.Flags;
+		MapHeights[index] = cell.Height;
+	}
+
+	UpdateMapDistances();
+}
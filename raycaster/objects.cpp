@@ -0,0 +1,212 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "objects.h"
+
+#include "raymath.h"
+
+// objects closer than this to the camera plane are not drawn
+constexpr float NearObjectDepth = 0.5f;
+
+// objects are one cell wide, so they can be seen when their center is up to half a cell outside the view
+constexpr float ObjectRadius = 0.5f;
+
+// if more objects than this come into view at once, sort the whole list instead of fixing it up
+constexpr size_t MaxInsertionSortAdds = 64;
+
+void ObjectGrid::Build(const std::vector<MapObject>& objects)
+{
+	Width = std::max((MapWidth + BucketSize - 1) / BucketSize, 1);
+	Height = std::max((MapHeight + BucketSize - 1) / BucketSize, 1);
+
+	size_t bucketCount = size_t(Width) * Height;
+
+	// count the objects in each bucket, then turn the counts into start offsets and place each object
+	BucketStart.assign(bucketCount + 1, 0);
+	BucketObjects.resize(objects.size());
+
+	for (const MapObject& obj : objects)
+		BucketStart[size_t(GetBucketY(obj.Position.y)) * Width + GetBucketX(obj.Position.x) + 1]++;
+
+	for (size_t i = 0; i < bucketCount; i++)
+		BucketStart[i + 1] += BucketStart[i];
+
+	// use the start of each bucket as a write cursor, once every object is placed it is the start of the next bucket
+	for (uint32_t i = 0; i < uint32_t(objects.size()); i++)
+	{
+		const MapObject& obj = objects[i];
+		size_t bucket = size_t(GetBucketY(obj.Position.y)) * Width + GetBucketX(obj.Position.x);
+		BucketObjects[BucketStart[bucket]++] = i;
+	}
+
+	// so move them back by one
+	for (size_t i = bucketCount; i > 0; i--)
+		BucketStart[i] = BucketStart[i - 1];
+	BucketStart[0] = 0;
+}
+
+void VisibleObjects::Update(const std::vector<MapObject>& objects, const ObjectGrid& grid, const RaycastCamera& camera, const RayResult* rays, int viewWidth, int viewHeight, int spriteFrames)
+{
+	FrameNumber++;
+
+	if (FoundFrame.size() != objects.size())
+	{
+		FoundFrame.assign(objects.size(), 0);
+		FoundSlot.resize(objects.size());
+	}
+
+	Found.clear();
+
+	// nothing can be seen past the farthest wall, unless a ray missed everything
+	float viewDistance = 0;
+	for (int i = 0; i < viewWidth; i++)
+	{
+		if (rays[i].Distance < 0)
+		{
+			viewDistance = float(MapWidth + MapHeight);
+			break;
+		}
+		viewDistance = std::max(viewDistance, rays[i].Distance);
+	}
+	viewDistance += ObjectRadius;
+
+	// the view is a triangle from the camera out to the view distance, look at the buckets around it
+	Vector2 leftEdge = Vector2Add(camera.Position, Vector2Scale(Vector2Subtract(camera.Facing, camera.Plane), viewDistance));
+	Vector2 rightEdge = Vector2Add(camera.Position, Vector2Scale(Vector2Add(camera.Facing, camera.Plane), viewDistance));
+
+	float minX = std::min({ camera.Position.x, leftEdge.x, rightEdge.x }) - ObjectRadius;
+	float minY = std::min({ camera.Position.y, leftEdge.y, rightEdge.y }) - ObjectRadius;
+	float maxX = std::max({ camera.Position.x, leftEdge.x, rightEdge.x }) + ObjectRadius;
+	float maxY = std::max({ camera.Position.y, leftEdge.y, rightEdge.y }) + ObjectRadius;
+
+	float invDet = 1.0f / (camera.Plane.x * camera.Facing.y - camera.Facing.x * camera.Plane.y); //required for correct matrix multiplication
+
+	grid.ForEachInArea(minX, minY, maxX, maxY, [&](uint32_t index)
+		{
+			const MapObject& obj = objects[index];
+
+			Vector2 relativePos = Vector2Subtract(obj.Position, camera.Position);
+
+			float transformX = invDet * (camera.Facing.y * relativePos.x - camera.Facing.x * relativePos.y);
+			float transformY = invDet * (-camera.Plane.y * relativePos.x + camera.Plane.x * relativePos.y); //this is actually the depth inside the screen, that what Z is in 3D
+
+			if (transformY < NearObjectDepth)
+				return;
+
+			ObjectSpan span;
+			span.Object = index;
+			span.Depth = transformY;
+
+			// the sprite is square, using 'transformY' instead of the real distance prevents fisheye
+			span.Size = int(viewHeight / transformY);
+			if (span.Size <= 0)
+				return;
+
+			int screenX = int((viewWidth / 2) * (1 + transformX / transformY));
+			span.Left = screenX - span.Size / 2;
+			span.Top = viewHeight / 2 - span.Size / 2;
+
+			int startColumn = std::max(span.Left, 0);
+			int endColumn = std::min(span.Left + span.Size, viewWidth);
+
+			// trim the span down to the columns where the object is in front of the walls, rays that missed are infinitely far away
+			while (startColumn < endColumn && rays[startColumn].Distance >= 0 && rays[startColumn].Distance <= transformY)
+				startColumn++;
+
+			while (endColumn > startColumn && rays[endColumn - 1].Distance >= 0 && rays[endColumn - 1].Distance <= transformY)
+				endColumn--;
+
+			if (startColumn >= endColumn)
+				return;
+
+			span.StartColumn = startColumn;
+			span.EndColumn = endColumn;
+
+			// pick the frame based on the angle we see the object from, wrapping around like a repeating texture
+			if (spriteFrames > 0)
+			{
+				float relativeAngle = atan2f(relativePos.y, relativePos.x) * RAD2DEG - 45;
+				span.Frame = int(floorf(fmodf(obj.Facing - relativeAngle, 360.0f) / 90.0f)) % spriteFrames;
+				if (span.Frame < 0)
+					span.Frame += spriteFrames;
+			}
+
+			FoundFrame[index] = FrameNumber;
+			FoundSlot[index] = uint32_t(Found.size());
+			Found.push_back(span);
+		});
+
+	// start with last frame's order for the objects that are still visible, then add the new ones to the end
+	size_t previousCount = Spans.size();
+	for (size_t i = 0; i < previousCount; i++)
+	{
+		uint32_t index = Spans[i].Object;
+		if (index >= objects.size() || FoundFrame[index] != FrameNumber)
+			continue;
+
+		Spans.push_back(Found[FoundSlot[index]]);
+
+		// mark it as placed
+		FoundFrame[index] = 0;
+	}
+	Spans.erase(Spans.begin(), Spans.begin() + previousCount);
+
+	size_t keptCount = Spans.size();
+
+	for (const ObjectSpan& span : Found)
+	{
+		if (FoundFrame[span.Object] == FrameNumber)
+			Spans.push_back(span);
+	}
+
+	auto farther = [](const ObjectSpan& a, const ObjectSpan& b) { return a.Depth > b.Depth; };
+
+	// when a lot of objects came into view (like the first frame) the list is not close to sorted, so do a full sort
+	if (Spans.size() - keptCount > MaxInsertionSortAdds)
+	{
+		std::stable_sort(Spans.begin(), Spans.end(), farther);
+		return;
+	}
+
+	// sort far to near. The list is almost in order already, so an insertion sort only moves the few objects that changed places.
+	// It is also stable, so objects at the same depth don't flicker
+	for (size_t i = 1; i < Spans.size(); i++)
+	{
+		ObjectSpan span = Spans[i];
+
+		size_t j = i;
+		while (j > 0 && farther(span, Spans[j - 1]))
+		{
+			Spans[j] = Spans[j - 1];
+			j--;
+		}
+
+		Spans[j] = span;
+	}
+}
@@ -0,0 +1,689 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "raycast.h"
+#include "map.h"
+
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef RAYCAST_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+bool SkipEmptySpace = true;
+bool UseFixedPointDDA = false;
+
+// find the first step count from start to end where the side distance has passed a time, or reached it when inclusive
+// this is where the DDA would be on that axis when the other axis steps at that time
+// the answer is estimated with a divide and then corrected so that it matches the step by step compares exactly
+static inline int FindNextStep(float sideDist0, float deltaDist, int start, int end, float time, bool inclusive)
+{
+	auto passed = [&](int steps)
+		{
+			float sideDist = sideDist0 + float(steps) * deltaDist;
+			return inclusive ? sideDist >= time : sideDist > time;
+		};
+
+	int steps = int(std::min(std::max((time - sideDist0) / deltaDist, float(start)), float(end)));
+
+	while (steps > start && passed(steps - 1))
+		steps--;
+
+	while (steps < end && !passed(steps))
+		steps++;
+
+	return steps;
+}
+
+// the state of one ray as the DDA walks it through the map
+struct RayWalk
+{
+	// The current grid point we are in
+	int MapX = 0;
+	int MapY = 0;
+
+	// what direction to step in x or y-direction (either +1 or -1)
+	int StepX = 0;
+	int StepY = 0;
+
+	// the side distances are computed from how many steps have been taken on each axis instead of being added up
+	// each step, that way jumping over empty space gives exactly the same distances as stepping through it
+	int StepsX = 0;
+	int StepsY = 0;
+	float SideDistX0 = 0;
+	float SideDistY0 = 0;
+
+	// length of ray from one x or y-side to next x or y-side
+	float DeltaDistX = 0;
+	float DeltaDistY = 0;
+
+	//length of ray from current position to next x or y-side
+	float SideDistX = 0;
+	float SideDistY = 0;
+
+	bool Side = false; //was a NS or a EW wall hit?
+};
+
+// setup the walk for a ray from the origin
+static inline void StartRayWalk(RayWalk& walk, const Vector2& origin, const Vector2& direction)
+{
+	walk.MapX = int(floor(origin.x));
+	walk.MapY = int(floor(origin.y));
+
+	// these are derived as:
+	// deltaDistX = sqrt(1 + (rayDirY * rayDirY) / (rayDirX * rayDirX))
+	// deltaDistY = sqrt(1 + (rayDirX * rayDirX) / (rayDirY * rayDirY))
+	// which can be simplified to abs(|rayDir| / rayDirX) and abs(|rayDir| / rayDirY)
+	// where |rayDir| is the length of the vector (rayDirX, rayDirY). Its length,
+	// unlike (dirX, dirY) is not 1, however this does not matter, only the
+	// ratio between deltaDistX and deltaDistY matters, due to the way the DDA
+	// stepping further below works. So the values can be computed as below.
+	// Division through zero is prevented, even though technically that's not
+	// needed in C++ with IEEE 754 floating point values.
+	walk.DeltaDistX = (direction.x == 0) ? float(1e30) : float(fabs(1.0f / direction.x));
+	walk.DeltaDistY = (direction.y == 0) ? float(1e30) : float(fabs(1.0f / direction.y));
+
+	// calculate step and initial sideDist
+	if (direction.x < 0)
+	{
+		walk.StepX = -1;
+		walk.SideDistX = (origin.x - walk.MapX) * walk.DeltaDistX;
+	}
+	else
+	{
+		walk.StepX = 1;
+		walk.SideDistX = (walk.MapX + 1.0f - origin.x) * walk.DeltaDistX;
+	}
+
+	if (direction.y < 0)
+	{
+		walk.StepY = -1;
+		walk.SideDistY = (origin.y - walk.MapY) * walk.DeltaDistY;
+	}
+	else
+	{
+		walk.StepY = 1;
+		walk.SideDistY = (walk.MapY + 1.0f - origin.y) * walk.DeltaDistY;
+	}
+
+	walk.SideDistX0 = walk.SideDistX;
+	walk.SideDistY0 = walk.SideDistY;
+	walk.StepsX = 0;
+	walk.StepsY = 0;
+	walk.Side = false;
+}
+
+// perform DDA Digital Differential Analyzer to walk the line until it enters a cell with a wall in it
+// returns false if the ray leaves the map first
+static inline bool WalkToNextWall(RayWalk& walk)
+{
+	for (;;)
+	{
+		//jump to next map square, either in x-direction, or in y-direction
+		if (walk.SideDistX < walk.SideDistY)
+		{
+			walk.StepsX++;
+			walk.SideDistX = walk.SideDistX0 + float(walk.StepsX) * walk.DeltaDistX;
+			walk.MapX += walk.StepX;
+			walk.Side = false;
+		}
+		else
+		{
+			walk.StepsY++;
+			walk.SideDistY = walk.SideDistY0 + float(walk.StepsY) * walk.DeltaDistY;
+			walk.MapY += walk.StepY;
+			walk.Side = true;
+		}
+
+		if (walk.MapX >= MapWidth || walk.MapX < 0 || walk.MapY >= MapHeight || walk.MapY < 0)
+			return false;
+
+		uint8_t distance = MapDistance[GetMapIndex(walk.MapX, walk.MapY)];
+
+		//Check if ray has hit a wall
+		if (distance == 0)
+			return true;
+
+		if (SkipEmptySpace && distance >= MinSkipDistance)
+		{
+			// every cell within distance - 1 of this one is empty, so move to the last cell the DDA would reach before
+			// it leaves that square. The axis that leaves the square first moves the whole way, the other axis
+			// takes every step that comes before that one
+			int reach = distance - 1;
+			float exitX = walk.SideDistX0 + float(walk.StepsX + reach) * walk.DeltaDistX;
+			float exitY = walk.SideDistY0 + float(walk.StepsY + reach) * walk.DeltaDistY;
+
+			int newStepsX = walk.StepsX + reach;
+			int newStepsY = walk.StepsY + reach;
+
+			// the DDA steps in Y when the side distances are equal, so Y steps happen up to and including the X exit
+			if (exitX < exitY)
+				newStepsY = FindNextStep(walk.SideDistY0, walk.DeltaDistY, walk.StepsY, newStepsY, exitX, false);
+			else
+				newStepsX = FindNextStep(walk.SideDistX0, walk.DeltaDistX, walk.StepsX, newStepsX, exitY, true);
+
+			walk.MapX += walk.StepX * (newStepsX - walk.StepsX);
+			walk.MapY += walk.StepY * (newStepsY - walk.StepsY);
+
+			walk.StepsX = newStepsX;
+			walk.StepsY = newStepsY;
+
+			walk.SideDistX = walk.SideDistX0 + float(walk.StepsX) * walk.DeltaDistX;
+			walk.SideDistY = walk.SideDistY0 + float(walk.StepsY) * walk.DeltaDistY;
+		}
+	}
+}
+
+// how far along the face of a wall a hit point is, the texture is mirrored on the far sides of a cell
+static inline float GetHitU(const Vector2& origin, const Vector2& direction, float distance, HitNormals normal)
+{
+	Vector2 target = Vector2Add(origin, Vector2Scale(direction, distance));
+
+	switch (normal)
+	{
+	case HitNormals::South:
+		return  target.x - floorf(target.x);
+
+	case HitNormals::North:
+		return  1.0f - (target.x - floorf(target.x));
+
+	case HitNormals::East:
+		return  target.y - floorf(target.y);
+
+	case HitNormals::West:
+		return  1.0f - (target.y - floorf(target.y));
+	}
+
+	return 0;
+}
+
+// find where the ray hits the wall in the cell the walk is in, returns false if it passes by
+static inline bool GetWallHit(const Vector2& origin, const Vector2& direction, const RayWalk& walk, RayLayer& hit)
+{
+	size_t cellIndex = GetMapIndex(walk.MapX, walk.MapY);
+	uint8_t flags = MapFlags[cellIndex];
+
+	hit.HitGridType = MapData[cellIndex];
+	hit.Height = MapHeights[cellIndex];
+
+	if ((flags & (CellFlagDoor | CellFlagThinWall)) == 0)
+	{
+		// Calculate distance projected on camera direction. This is the shortest distance from the point where the wall is
+		// hit to the camera plane. Euclidean to center camera point would give fisheye effect!
+		// This can be computed as (mapX - posX + (1 - stepX) / 2) / rayDirX for side == 0, or same formula with Y
+		// for size == 1, but can be simplified to the code below thanks to how sideDist and deltaDist are computed:
+		// because they were left scaled to |rayDir|. sideDist is the entire length of the ray above after the multiple
+		// steps, but we subtract deltaDist once because one step more into the wall was taken above.
+		if (!walk.Side)
+		{
+			hit.Distance = (walk.SideDistX - walk.DeltaDistX);
+			hit.Normal = walk.StepX < 0 ? HitNormals::East : HitNormals::West;
+		}
+		else
+		{
+			hit.Distance = (walk.SideDistY - walk.DeltaDistY);
+			hit.Normal = walk.StepY < 0 ? HitNormals::North : HitNormals::South;
+		}
+
+		hit.U = GetHitU(origin, direction, hit.Distance, hit.Normal);
+		return true;
+	}
+
+	// thin walls and doors are a plane through the middle of the cell, the ray crosses it half a step before it
+	// would leave the cell on that axis. That is only a hit if it happens while the ray is inside this cell
+	float enter = walk.Side ? walk.SideDistY - walk.DeltaDistY : walk.SideDistX - walk.DeltaDistX;
+	float exit = fminf(walk.SideDistX, walk.SideDistY);
+
+	float along = 0;
+	if (flags & CellFlagAlongX)
+	{
+		hit.Distance = walk.SideDistY - walk.DeltaDistY * 0.5f;
+		hit.Normal = walk.StepY < 0 ? HitNormals::North : HitNormals::South;
+		along = origin.x + direction.x * hit.Distance;
+	}
+	else
+	{
+		hit.Distance = walk.SideDistX - walk.DeltaDistX * 0.5f;
+		hit.Normal = walk.StepX < 0 ? HitNormals::East : HitNormals::West;
+		along = origin.y + direction.y * hit.Distance;
+	}
+
+	if (hit.Distance < enter || hit.Distance >= exit)
+		return false;
+
+	along -= floorf(along);
+
+	// doors slide towards the low side of the cell, so the ray passes through the part that has opened up,
+	// and the texture moves with the door
+	if (flags & CellFlagDoor)
+	{
+		float open = MapDoorOpen[cellIndex] / 255.0f;
+		if (along < open)
+			return false;
+
+		along -= open;
+	}
+
+	hit.U = (hit.Normal == HitNormals::North || hit.Normal == HitNormals::West) ? 1.0f - along : along;
+	return true;
+}
+
+// find what the ray hits starting from a cell with a wall in it, short walls are stored as layers and the walk goes
+// on until it finds a wall that is as tall as the view, or leaves the map
+static void FinishRay(const Vector2& origin, RayWalk& walk, RayResult& ray)
+{
+	ray.LayerCount = 0;
+
+	do
+	{
+		RayLayer hit;
+		if (!GetWallHit(origin, ray.Directon, walk, hit))
+			continue;
+
+		if (hit.Height < FullWallHeight)
+		{
+			// anything past the last layer is not drawn
+			if (ray.LayerCount < MaxRayLayers)
+				ray.Layers[ray.LayerCount++] = hit;
+			continue;
+		}
+
+		ray.Distance = hit.Distance;
+		ray.Normal = hit.Normal;
+		ray.HitGridType = hit.HitGridType;
+		ray.U = hit.U;
+		return;
+	}
+	while (WalkToNextWall(walk));
+
+	ray.Distance = -1;
+	ray.HitGridType = 0;
+}
+
+// cast a ray and find out what it hits
+void CastRay(const Vector2& origin, RayResult& ray)
+{
+	if (UseFixedPointDDA)
+	{
+		CastRayFixed(origin, ray);
+		return;
+	}
+
+	RayWalk walk;
+	StartRayWalk(walk, origin, ray.Directon);
+
+	if (!WalkToNextWall(walk))
+	{
+		ray.Distance = -1;
+		ray.HitGridType = 0;
+		ray.LayerCount = 0;
+		return;
+	}
+
+	FinishRay(origin, walk, ray);
+}
+
+// figure out how far from the edge of a cell the current ray is
+float GetRayU(const Vector2& origin, const RayResult& ray)
+{
+	return GetHitU(origin, ray.Directon, ray.Distance, ray.Normal);
+}
+
+#ifdef RAYCAST_USE_SSE2
+
+// pick a where the mask is set, b where it is not
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128i Select(__m128i mask, __m128i a, __m128i b)
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// multiply the 32 bit lanes and keep the low 32 bits, SSE2 only has a 32 x 32 -> 64 bit multiply for even lanes
+static inline __m128i MultiplyLanes(__m128i a, __m128i b)
+{
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// the state of 4 rays being walked together by the DDA, one ray per SIMD lane
+struct RayLanes
+{
+	__m128 SideDistX;
+	__m128 SideDistY;
+	__m128 DeltaDistX;
+	__m128 DeltaDistY;
+
+	// the side distances are computed from the starting distance and the number of steps on each axis, like CastRay
+	// the step counts are kept as floats, they are whole numbers well under the 24 bits a float holds exactly
+	__m128 SideDistX0;
+	__m128 SideDistY0;
+	__m128 StepsX;
+	__m128 StepsY;
+
+	// instead of tracking the map position, track the index of the current cell in the map data
+	// and how many steps each lane can take on each axis before it leaves the map
+	__m128i CellIndex;
+	__m128i StrideX;
+	__m128i StrideY;
+	__m128i StepsLeftX;
+	__m128i StepsLeftY;
+
+	__m128i Active;		// lanes that are still walking
+	__m128i Hit;		// lanes that hit a wall
+	__m128i SideY;		// lanes that last stepped in Y (a NS wall)
+	__m128i Distance;	// the map distance of the cell each lane is in
+};
+
+// setup 4 rays from an origin inside the map, this is the same math as the start of CastRay
+static inline void StartLanes(RayLanes& lanes, const Vector2& origin, const RayResult* rays)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	const __m128 farDistance = _mm_set1_ps(float(1e30));
+
+	// The current grid point we are in, the same for every lane
+	int startX = int(floor(origin.x));
+	int startY = int(floor(origin.y));
+
+	__m128 posX = _mm_set1_ps(origin.x);
+	__m128 posY = _mm_set1_ps(origin.y);
+	__m128 mapX = _mm_set1_ps(float(startX));
+	__m128 mapY = _mm_set1_ps(float(startY));
+
+	__m128 dirX = _mm_setr_ps(rays[0].Directon.x, rays[1].Directon.x, rays[2].Directon.x, rays[3].Directon.x);
+	__m128 dirY = _mm_setr_ps(rays[0].Directon.y, rays[1].Directon.y, rays[2].Directon.y, rays[3].Directon.y);
+
+	// length of ray from one x or y-side to next x or y-side
+	lanes.DeltaDistX = Select(_mm_cmpeq_ps(dirX, zero), farDistance, _mm_and_ps(_mm_div_ps(one, dirX), absMask));
+	lanes.DeltaDistY = Select(_mm_cmpeq_ps(dirY, zero), farDistance, _mm_and_ps(_mm_div_ps(one, dirY), absMask));
+
+	// the compare masks are all ones for rays going in the negative direction
+	__m128i negativeX = _mm_castps_si128(_mm_cmplt_ps(dirX, zero));
+	__m128i negativeY = _mm_castps_si128(_mm_cmplt_ps(dirY, zero));
+
+	// length of ray from current position to next x or y-side
+	lanes.SideDistX = Select(_mm_castsi128_ps(negativeX), _mm_mul_ps(_mm_sub_ps(posX, mapX), lanes.DeltaDistX), _mm_mul_ps(_mm_sub_ps(_mm_add_ps(mapX, one), posX), lanes.DeltaDistX));
+	lanes.SideDistY = Select(_mm_castsi128_ps(negativeY), _mm_mul_ps(_mm_sub_ps(posY, mapY), lanes.DeltaDistY), _mm_mul_ps(_mm_sub_ps(_mm_add_ps(mapY, one), posY), lanes.DeltaDistY));
+
+	lanes.SideDistX0 = lanes.SideDistX;
+	lanes.SideDistY0 = lanes.SideDistY;
+	lanes.StepsX = zero;
+	lanes.StepsY = zero;
+
+	lanes.CellIndex = _mm_set1_epi32(startY * MapWidth + startX);
+	lanes.StrideX = Select(negativeX, _mm_set1_epi32(-1), _mm_set1_epi32(1));
+	lanes.StrideY = Select(negativeY, _mm_set1_epi32(-MapWidth), _mm_set1_epi32(MapWidth));
+
+	lanes.StepsLeftX = Select(negativeX, _mm_set1_epi32(startX), _mm_set1_epi32(MapWidth - 1 - startX));
+	lanes.StepsLeftY = Select(negativeY, _mm_set1_epi32(startY), _mm_set1_epi32(MapHeight - 1 - startY));
+
+	lanes.Active = _mm_set1_epi32(-1);
+	lanes.Hit = _mm_setzero_si128();
+	lanes.SideY = _mm_setzero_si128();
+	lanes.Distance = _mm_setzero_si128();
+}
+
+// take one DDA step on every active lane
+static inline void StepLanes(RayLanes& lanes)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	//jump to next map square, either in x-direction, or in y-direction
+	__m128i takeX = _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(lanes.SideDistX, lanes.SideDistY)), lanes.Active);
+	__m128i takeY = _mm_andnot_si128(takeX, lanes.Active);
+
+	lanes.StepsX = _mm_add_ps(lanes.StepsX, _mm_and_ps(_mm_castsi128_ps(takeX), one));
+	lanes.StepsY = _mm_add_ps(lanes.StepsY, _mm_and_ps(_mm_castsi128_ps(takeY), one));
+
+	lanes.SideDistX = _mm_add_ps(lanes.SideDistX0, _mm_mul_ps(lanes.StepsX, lanes.DeltaDistX));
+	lanes.SideDistY = _mm_add_ps(lanes.SideDistY0, _mm_mul_ps(lanes.StepsY, lanes.DeltaDistY));
+
+	lanes.CellIndex = _mm_add_epi32(lanes.CellIndex, _mm_or_si128(_mm_and_si128(takeX, lanes.StrideX), _mm_and_si128(takeY, lanes.StrideY)));
+
+	// the take masks are -1, so adding them counts down the steps left
+	lanes.StepsLeftX = _mm_add_epi32(lanes.StepsLeftX, takeX);
+	lanes.StepsLeftY = _mm_add_epi32(lanes.StepsLeftY, takeY);
+
+	// inactive lanes don't step, so only the active lanes change side
+	lanes.SideY = _mm_or_si128(takeY, _mm_andnot_si128(lanes.Active, lanes.SideY));
+
+	// lanes that leave the map are done, and did not hit anything
+	lanes.Active = _mm_andnot_si128(_mm_srai_epi32(_mm_or_si128(lanes.StepsLeftX, lanes.StepsLeftY), 31), lanes.Active);
+
+	// there is no gather in SSE2, so read the cell for each lane one at a time
+	// lanes that are done read cell 0 and are masked off below
+	alignas(16) int32_t laneIndex[4];
+	_mm_store_si128((__m128i*)laneIndex, _mm_and_si128(lanes.CellIndex, lanes.Active));
+
+	lanes.Distance = _mm_setr_epi32(MapDistance[laneIndex[0]], MapDistance[laneIndex[1]], MapDistance[laneIndex[2]], MapDistance[laneIndex[3]]);
+
+	//Check if ray has hit a wall, walls have a distance of 0
+	__m128i hitNow = _mm_and_si128(_mm_cmpeq_epi32(lanes.Distance, _mm_setzero_si128()), lanes.Active);
+
+	lanes.Hit = _mm_or_si128(lanes.Hit, hitNow);
+	lanes.Active = _mm_andnot_si128(hitNow, lanes.Active);
+}
+
+// lanes in a cell with a large enough distance jump over the empty square around it, this is the same as the jump in CastRay
+static inline __m128i GetSkipLanes(const RayLanes& lanes)
+{
+	return _mm_and_si128(_mm_cmpgt_epi32(lanes.Distance, _mm_set1_epi32(MinSkipDistance - 1)), lanes.Active);
+}
+
+static inline void SkipLanes(RayLanes& lanes, __m128i skip)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+	__m128 skipMask = _mm_castsi128_ps(skip);
+
+	// lanes that don't skip have a reach of 0, and the search below leaves them where they are
+	__m128 reach = _mm_and_ps(skipMask, _mm_cvtepi32_ps(_mm_sub_epi32(lanes.Distance, _mm_set1_epi32(1))));
+
+	__m128 exitX = _mm_add_ps(lanes.SideDistX0, _mm_mul_ps(_mm_add_ps(lanes.StepsX, reach), lanes.DeltaDistX));
+	__m128 exitY = _mm_add_ps(lanes.SideDistY0, _mm_mul_ps(_mm_add_ps(lanes.StepsY, reach), lanes.DeltaDistY));
+
+	// the axis that leaves the square first moves the whole way, the other axis is searched for the first step
+	// that comes after that, which is a step past the exit time in Y, or a step at or past the exit time in X
+	__m128 exitOnX = _mm_cmplt_ps(exitX, exitY);
+
+	__m128 time = Select(exitOnX, exitX, exitY);
+	__m128 sideDist0 = Select(exitOnX, lanes.SideDistY0, lanes.SideDistX0);
+	__m128 deltaDist = Select(exitOnX, lanes.DeltaDistY, lanes.DeltaDistX);
+	__m128 start = Select(exitOnX, lanes.StepsY, lanes.StepsX);
+	__m128 end = _mm_add_ps(start, reach);
+
+	auto passed = [&](__m128 steps)
+		{
+			__m128 sideDist = _mm_add_ps(sideDist0, _mm_mul_ps(steps, deltaDist));
+			return Select(exitOnX, _mm_cmpgt_ps(sideDist, time), _mm_cmpge_ps(sideDist, time));
+		};
+
+	// estimate the step with a divide, then correct it so it matches the step by step compares exactly
+	__m128 estimate = _mm_min_ps(_mm_max_ps(_mm_div_ps(_mm_sub_ps(time, sideDist0), deltaDist), start), end);
+	__m128 steps = _mm_cvtepi32_ps(_mm_cvttps_epi32(estimate));
+
+	for (;;)
+	{
+		__m128 back = _mm_and_ps(_mm_cmpgt_ps(steps, start), passed(_mm_sub_ps(steps, one)));
+		if (_mm_movemask_ps(back) == 0)
+			break;
+
+		steps = _mm_sub_ps(steps, _mm_and_ps(back, one));
+	}
+
+	for (;;)
+	{
+		__m128 forward = _mm_andnot_ps(passed(steps), _mm_cmplt_ps(steps, end));
+		if (_mm_movemask_ps(forward) == 0)
+			break;
+
+		steps = _mm_add_ps(steps, _mm_and_ps(forward, one));
+	}
+
+	__m128 newStepsX = Select(skipMask, Select(exitOnX, _mm_add_ps(lanes.StepsX, reach), steps), lanes.StepsX);
+	__m128 newStepsY = Select(skipMask, Select(exitOnX, steps, _mm_add_ps(lanes.StepsY, reach)), lanes.StepsY);
+
+	__m128i movedX = _mm_cvttps_epi32(_mm_sub_ps(newStepsX, lanes.StepsX));
+	__m128i movedY = _mm_cvttps_epi32(_mm_sub_ps(newStepsY, lanes.StepsY));
+
+	lanes.CellIndex = _mm_add_epi32(lanes.CellIndex, _mm_add_epi32(MultiplyLanes(movedX, lanes.StrideX), MultiplyLanes(movedY, lanes.StrideY)));
+	lanes.StepsLeftX = _mm_sub_epi32(lanes.StepsLeftX, movedX);
+	lanes.StepsLeftY = _mm_sub_epi32(lanes.StepsLeftY, movedY);
+
+	lanes.StepsX = newStepsX;
+	lanes.StepsY = newStepsY;
+
+	lanes.SideDistX = _mm_add_ps(lanes.SideDistX0, _mm_mul_ps(lanes.StepsX, lanes.DeltaDistX));
+	lanes.SideDistY = _mm_add_ps(lanes.SideDistY0, _mm_mul_ps(lanes.StepsY, lanes.DeltaDistY));
+}
+
+// write the lanes back into the ray results. Lanes that found a wall hand their walk over to FinishRay, so doors,
+// thin walls and short walls are handled the same way as CastRay does it
+static inline void FinishLanes(const RayLanes& lanes, const Vector2& origin, RayResult* rays)
+{
+	alignas(16) float laneSideDistX[4];
+	alignas(16) float laneSideDistY[4];
+	alignas(16) float laneDeltaDistX[4];
+	alignas(16) float laneDeltaDistY[4];
+	alignas(16) float laneSideDistX0[4];
+	alignas(16) float laneSideDistY0[4];
+	alignas(16) float laneStepsX[4];
+	alignas(16) float laneStepsY[4];
+	alignas(16) int32_t laneIndex[4];
+	alignas(16) int32_t laneHit[4];
+	alignas(16) int32_t laneSideY[4];
+
+	_mm_store_ps(laneSideDistX, lanes.SideDistX);
+	_mm_store_ps(laneSideDistY, lanes.SideDistY);
+	_mm_store_ps(laneDeltaDistX, lanes.DeltaDistX);
+	_mm_store_ps(laneDeltaDistY, lanes.DeltaDistY);
+	_mm_store_ps(laneSideDistX0, lanes.SideDistX0);
+	_mm_store_ps(laneSideDistY0, lanes.SideDistY0);
+	_mm_store_ps(laneStepsX, lanes.StepsX);
+	_mm_store_ps(laneStepsY, lanes.StepsY);
+	_mm_store_si128((__m128i*)laneIndex, lanes.CellIndex);
+	_mm_store_si128((__m128i*)laneHit, lanes.Hit);
+	_mm_store_si128((__m128i*)laneSideY, lanes.SideY);
+
+	for (size_t lane = 0; lane < 4; lane++)
+	{
+		RayResult& ray = rays[lane];
+
+		if (!laneHit[lane])
+		{
+			ray.Distance = -1;
+			ray.HitGridType = 0;
+			ray.LayerCount = 0;
+			continue;
+		}
+
+		RayWalk walk;
+		walk.MapX = laneIndex[lane] % MapWidth;
+		walk.MapY = laneIndex[lane] / MapWidth;
+		walk.StepX = ray.Directon.x < 0 ? -1 : 1;
+		walk.StepY = ray.Directon.y < 0 ? -1 : 1;
+		walk.StepsX = int(laneStepsX[lane]);
+		walk.StepsY = int(laneStepsY[lane]);
+		walk.SideDistX0 = laneSideDistX0[lane];
+		walk.SideDistY0 = laneSideDistY0[lane];
+		walk.DeltaDistX = laneDeltaDistX[lane];
+		walk.DeltaDistY = laneDeltaDistY[lane];
+		walk.SideDistX = laneSideDistX[lane];
+		walk.SideDistY = laneSideDistY[lane];
+		walk.Side = laneSideY[lane] != 0;
+
+		FinishRay(origin, walk, ray);
+	}
+}
+
+// cast RayPacketSize rays at once from an origin inside the map.
+// Each lane runs the exact same DDA as CastRay, using the same float operations in the same order, so the results match.
+// The packet is two groups of 4 lanes that are stepped together, so that one group's compare and add can run while the
+// other is waiting on it's map reads. Lanes that have hit something or left the map are masked off,
+// and the loop stops as soon as every lane is done.
+static void CastRayPacket(const Vector2& origin, RayResult* rays)
+{
+	static_assert(RayPacketSize == 8, "SSE2 packets are two groups of 4 lanes");
+
+	RayLanes first;
+	RayLanes second;
+
+	StartLanes(first, origin, rays);
+	StartLanes(second, origin, rays + 4);
+
+	// perform the DDA on all lanes until every lane has hit something or left the map
+	while (_mm_movemask_epi8(_mm_or_si128(first.Active, second.Active)) != 0)
+	{
+		StepLanes(first);
+		StepLanes(second);
+
+		if (!SkipEmptySpace)
+			continue;
+
+		__m128i skipFirst = GetSkipLanes(first);
+		if (_mm_movemask_epi8(skipFirst) != 0)
+			SkipLanes(first, skipFirst);
+
+		__m128i skipSecond = GetSkipLanes(second);
+		if (_mm_movemask_epi8(skipSecond) != 0)
+			SkipLanes(second, skipSecond);
+	}
+
+	FinishLanes(first, origin, rays);
+	FinishLanes(second, origin, rays + 4);
+}
+
+#endif // RAYCAST_USE_SSE2
+
+void CastRays(const Vector2& origin, RayResult* rays, size_t count)
+{
+	size_t i = 0;
+
+#ifdef RAYCAST_USE_SSE2
+	// the packet caster tracks how far each lane is from the map edge, so it needs to start inside the map
+	// fixed point rays are always cast one at a time
+	if (!UseFixedPointDDA && origin.x >= 0 && origin.y >= 0 && origin.x < MapWidth && origin.y < MapHeight)
+	{
+		for (; i + RayPacketSize <= count; i += RayPacketSize)
+			CastRayPacket(origin, rays + i);
+	}
+#endif
+
+	// anything that doesn't fill a packet is cast on it's own
+	for (; i < count; i++)
+		CastRay(origin, rays[i]);
+}
@@ -0,0 +1,318 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "raycast.h"
+#include "map.h"
+
+#include <algorithm>
+#include <cstdint>
+
+// The fixed point caster walks the same DDA as CastRay using 16.16 fixed point numbers instead of floats.
+// Every step is integer math, so the results only depend on the inputs and not on the compiler, the instruction set
+// or the floating point settings. Floats are only used to bring the origin and direction in and the results out,
+// and those conversions are exact or rounded the same way everywhere.
+
+// 16.16 fixed point, kept in 64 bits so that a side distance times a step count can't overflow
+using Fixed = int64_t;
+
+constexpr int FixedShift = 16;
+constexpr Fixed FixedOne = Fixed(1) << FixedShift;
+constexpr Fixed FixedFraction = FixedOne - 1;
+
+// the step distance for an axis the ray does not move on, far enough to never be reached and small enough that
+// multiplying it by a cell fraction still fits
+constexpr Fixed FixedFar = Fixed(1) << 44;
+
+// scaling by a power of two is exact, and the conversion truncates the same way on every compiler
+static inline Fixed ToFixed(float value)
+{
+	return Fixed(value * float(FixedOne));
+}
+
+static inline float FromFixed(Fixed value)
+{
+	return float(value) / float(FixedOne);
+}
+
+// the shift of a negative value rounds down, this is what every compiler we build with does
+static inline Fixed FixedMultiply(Fixed a, Fixed b)
+{
+	return (a * b) >> FixedShift;
+}
+
+// the state of one ray as the fixed point DDA walks it through the map, this is RayWalk with fixed point distances
+struct FixedRayWalk
+{
+	Fixed PosX = 0;
+	Fixed PosY = 0;
+	Fixed DirX = 0;
+	Fixed DirY = 0;
+
+	int MapX = 0;
+	int MapY = 0;
+
+	int StepX = 0;
+	int StepY = 0;
+
+	int StepsX = 0;
+	int StepsY = 0;
+	Fixed SideDistX0 = 0;
+	Fixed SideDistY0 = 0;
+
+	Fixed DeltaDistX = 0;
+	Fixed DeltaDistY = 0;
+
+	Fixed SideDistX = 0;
+	Fixed SideDistY = 0;
+
+	bool Side = false;
+};
+
+// the fixed point version of FindNextStep, the divide gives the answer directly and the compares only fix the rounding
+static inline int FindNextStepFixed(Fixed sideDist0, Fixed deltaDist, int start, int end, Fixed time, bool inclusive)
+{
+	auto passed = [&](int steps)
+		{
+			Fixed sideDist = sideDist0 + steps * deltaDist;
+			return inclusive ? sideDist >= time : sideDist > time;
+		};
+
+	int steps = int(std::min(std::max((time - sideDist0) / deltaDist, Fixed(start)), Fixed(end)));
+
+	while (steps > start && passed(steps - 1))
+		steps--;
+
+	while (steps < end && !passed(steps))
+		steps++;
+
+	return steps;
+}
+
+static inline void StartFixedRayWalk(FixedRayWalk& walk, const Vector2& origin, const Vector2& direction)
+{
+	walk.PosX = ToFixed(origin.x);
+	walk.PosY = ToFixed(origin.y);
+	walk.DirX = ToFixed(direction.x);
+	walk.DirY = ToFixed(direction.y);
+
+	walk.MapX = int(walk.PosX >> FixedShift);
+	walk.MapY = int(walk.PosY >> FixedShift);
+
+	// the length of the ray from one side to the next is 1 / |dir|, which is FixedOne * FixedOne / |dir| in fixed point
+	walk.DeltaDistX = walk.DirX == 0 ? FixedFar : (FixedOne * FixedOne) / (walk.DirX < 0 ? -walk.DirX : walk.DirX);
+	walk.DeltaDistY = walk.DirY == 0 ? FixedFar : (FixedOne * FixedOne) / (walk.DirY < 0 ? -walk.DirY : walk.DirY);
+
+	Fixed cellX = Fixed(walk.MapX) << FixedShift;
+	Fixed cellY = Fixed(walk.MapY) << FixedShift;
+
+	if (walk.DirX < 0)
+	{
+		walk.StepX = -1;
+		walk.SideDistX = FixedMultiply(walk.PosX - cellX, walk.DeltaDistX);
+	}
+	else
+	{
+		walk.StepX = 1;
+		walk.SideDistX = FixedMultiply(cellX + FixedOne - walk.PosX, walk.DeltaDistX);
+	}
+
+	if (walk.DirY < 0)
+	{
+		walk.StepY = -1;
+		walk.SideDistY = FixedMultiply(walk.PosY - cellY, walk.DeltaDistY);
+	}
+	else
+	{
+		walk.StepY = 1;
+		walk.SideDistY = FixedMultiply(cellY + FixedOne - walk.PosY, walk.DeltaDistY);
+	}
+
+	walk.SideDistX0 = walk.SideDistX;
+	walk.SideDistY0 = walk.SideDistY;
+}
+
+// the same walk as WalkToNextWall, returns false if the ray leaves the map before it finds a wall
+static inline bool WalkToNextWallFixed(FixedRayWalk& walk)
+{
+	for (;;)
+	{
+		if (walk.SideDistX < walk.SideDistY)
+		{
+			walk.StepsX++;
+			walk.SideDistX = walk.SideDistX0 + walk.StepsX * walk.DeltaDistX;
+			walk.MapX += walk.StepX;
+			walk.Side = false;
+		}
+		else
+		{
+			walk.StepsY++;
+			walk.SideDistY = walk.SideDistY0 + walk.StepsY * walk.DeltaDistY;
+			walk.MapY += walk.StepY;
+			walk.Side = true;
+		}
+
+		if (walk.MapX >= MapWidth || walk.MapX < 0 || walk.MapY >= MapHeight || walk.MapY < 0)
+			return false;
+
+		uint8_t distance = MapDistance[GetMapIndex(walk.MapX, walk.MapY)];
+
+		if (distance == 0)
+			return true;
+
+		if (SkipEmptySpace && distance >= MinSkipDistance)
+		{
+			int reach = distance - 1;
+			Fixed exitX = walk.SideDistX0 + (walk.StepsX + reach) * walk.DeltaDistX;
+			Fixed exitY = walk.SideDistY0 + (walk.StepsY + reach) * walk.DeltaDistY;
+
+			int newStepsX = walk.StepsX + reach;
+			int newStepsY = walk.StepsY + reach;
+
+			if (exitX < exitY)
+				newStepsY = FindNextStepFixed(walk.SideDistY0, walk.DeltaDistY, walk.StepsY, newStepsY, exitX, false);
+			else
+				newStepsX = FindNextStepFixed(walk.SideDistX0, walk.DeltaDistX, walk.StepsX, newStepsX, exitY, true);
+
+			walk.MapX += walk.StepX * (newStepsX - walk.StepsX);
+			walk.MapY += walk.StepY * (newStepsY - walk.StepsY);
+
+			walk.StepsX = newStepsX;
+			walk.StepsY = newStepsY;
+
+			walk.SideDistX = walk.SideDistX0 + walk.StepsX * walk.DeltaDistX;
+			walk.SideDistY = walk.SideDistY0 + walk.StepsY * walk.DeltaDistY;
+		}
+	}
+}
+
+// the texture U for a hit, from how far along the face of the cell it is, mirrored on the far sides like GetRayU
+static inline float GetFixedHitU(Fixed along, HitNormals normal)
+{
+	if (normal == HitNormals::North || normal == HitNormals::West)
+		along = FixedOne - along;
+
+	return FromFixed(along);
+}
+
+// the same hit test as GetWallHit, returns false if the ray passes by the wall in this cell
+static inline bool GetWallHitFixed(const FixedRayWalk& walk, RayLayer& hit)
+{
+	size_t cellIndex = GetMapIndex(walk.MapX, walk.MapY);
+	uint8_t flags = MapFlags[cellIndex];
+
+	hit.HitGridType = MapData[cellIndex];
+	hit.Height = MapHeights[cellIndex];
+
+	Fixed distance = 0;
+	Fixed along = 0;
+
+	if ((flags & (CellFlagDoor | CellFlagThinWall)) == 0)
+	{
+		if (!walk.Side)
+		{
+			distance = walk.SideDistX - walk.DeltaDistX;
+			hit.Normal = walk.StepX < 0 ? HitNormals::East : HitNormals::West;
+			along = (walk.PosY + FixedMultiply(walk.DirY, distance)) & FixedFraction;
+		}
+		else
+		{
+			distance = walk.SideDistY - walk.DeltaDistY;
+			hit.Normal = walk.StepY < 0 ? HitNormals::North : HitNormals::South;
+			along = (walk.PosX + FixedMultiply(walk.DirX, distance)) & FixedFraction;
+		}
+
+		hit.Distance = FromFixed(distance);
+		hit.U = GetFixedHitU(along, hit.Normal);
+		return true;
+	}
+
+	// thin walls and doors are a plane through the middle of the cell
+	Fixed enter = walk.Side ? walk.SideDistY - walk.DeltaDistY : walk.SideDistX - walk.DeltaDistX;
+	Fixed exit = std::min(walk.SideDistX, walk.SideDistY);
+
+	if (flags & CellFlagAlongX)
+	{
+		distance = walk.SideDistY - walk.DeltaDistY / 2;
+		hit.Normal = walk.StepY < 0 ? HitNormals::North : HitNormals::South;
+		along = (walk.PosX + FixedMultiply(walk.DirX, distance)) & FixedFraction;
+	}
+	else
+	{
+		distance = walk.SideDistX - walk.DeltaDistX / 2;
+		hit.Normal = walk.StepX < 0 ? HitNormals::East : HitNormals::West;
+		along = (walk.PosY + FixedMultiply(walk.DirY, distance)) & FixedFraction;
+	}
+
+	if (distance < enter || distance >= exit)
+		return false;
+
+	if (flags & CellFlagDoor)
+	{
+		Fixed open = (MapDoorOpen[cellIndex] * FixedOne) / 255;
+		if (along < open)
+			return false;
+
+		along -= open;
+	}
+
+	hit.Distance = FromFixed(distance);
+	hit.U = GetFixedHitU(along, hit.Normal);
+	return true;
+}
+
+void CastRayFixed(const Vector2& origin, RayResult& ray)
+{
+	FixedRayWalk walk;
+	StartFixedRayWalk(walk, origin, ray.Directon);
+
+	ray.LayerCount = 0;
+
+	while (WalkToNextWallFixed(walk))
+	{
+		RayLayer hit;
+		if (!GetWallHitFixed(walk, hit))
+			continue;
+
+		if (hit.Height < FullWallHeight)
+		{
+			if (ray.LayerCount < MaxRayLayers)
+				ray.Layers[ray.LayerCount++] = hit;
+			continue;
+		}
+
+		ray.Distance = hit.Distance;
+		ray.Normal = hit.Normal;
+		ray.HitGridType = hit.HitGridType;
+		ray.U = hit.U;
+		return;
+	}
+
+	ray.Distance = -1;
+	ray.HitGridType = 0;
+}
@@ -0,0 +1,95 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "raycast_view.h"
+
+#include <algorithm>
+
+void RaycastView::Resize(int width, int height)
+{
+	Columns.Build(width);
+	Rays.resize(width);
+	Frame.Resize(width, height);
+	WallColumns.Resize(width);
+}
+
+static int GetBandCount(const RaycastView& view)
+{
+	return (view.GetWidth() + ViewBandWidth - 1) / ViewBandWidth;
+}
+
+// run a task for every band of every view, the task gets the view and the range of columns in the band
+template<class Func>
+static void RunViewBands(std::vector<RaycastView>& views, ThreadPool& workers, Func&& func)
+{
+	// the first task of each view, so a task number can be turned back into a view and a band
+	std::vector<size_t> firstTask(views.size() + 1, 0);
+	for (size_t i = 0; i < views.size(); i++)
+		firstTask[i + 1] = firstTask[i] + GetBandCount(views[i]);
+
+	workers.Run(firstTask.back(), [&](size_t task)
+		{
+			size_t viewIndex = std::upper_bound(firstTask.begin(), firstTask.end(), task) - firstTask.begin() - 1;
+			RaycastView& view = views[viewIndex];
+
+			int startColumn = int(task - firstTask[viewIndex]) * ViewBandWidth;
+			int endColumn = std::min(startColumn + ViewBandWidth, view.GetWidth());
+
+			func(view, startColumn, endColumn);
+		});
+}
+
+void CastViews(std::vector<RaycastView>& views, ThreadPool& workers)
+{
+	RunViewBands(views, workers, [](RaycastView& view, int startColumn, int endColumn)
+		{
+			CastViewColumns(view.Camera, view.Columns, view.Rays.data(), startColumn, endColumn);
+		});
+}
+
+void FindViewObjects(std::vector<RaycastView>& views, const std::vector<MapObject>& objects, const ObjectGrid& grid, int spriteFrames, ThreadPool& workers)
+{
+	workers.Run(views.size(), [&](size_t index)
+		{
+			RaycastView& view = views[index];
+			view.Objects.Update(objects, grid, view.Camera, view.Rays.data(), view.GetWidth(), view.GetHeight(), spriteFrames);
+		});
+}
+
+void DrawViews(std::vector<RaycastView>& views, const SoftwareScene& scene, ThreadPool& workers)
+{
+	RunViewBands(views, workers, [&scene](RaycastView& view, int startColumn, int endColumn)
+		{
+			SoftwareScene viewScene = scene;
+			viewScene.Objects = view.Objects.Spans.data();
+			viewScene.ObjectCount = view.Objects.Spans.size();
+
+			DrawViewColumns(view.Frame, view.WallColumns, view.Camera, viewScene, view.Rays.data(), startColumn, endColumn);
+		});
+}
@@ -29,66 +29,61 @@
 #include "raylib.h"
 #include "raymath.h"
 
+#include "benchmark.h"
+#include "map.h"
+#include "objects.h"
+#include "raycast.h"
+#include "raycast_view.h"
+#include "software_renderer.h"
+#include "thread_pool.h"
+
+#include <cfloat>
 #include <cstdint>
 #include <vector>
 #include <algorithm>
 
-// the grid of map data
-uint8_t MapData[] = { 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 7, 7, 7, 7, 7, 7, 7, 7,
-						4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0 ,0, 0, 0, 0, 0, 7,
-						4, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7,
-						4, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7,
-						4, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 0, 0, 7,
-						4, 0, 4, 0, 0, 0, 0, 5, 5, 5, 5, 5, 5, 5, 5, 5, 7, 7, 0, 7, 7, 7, 7, 7,
-						4, 0, 5, 0, 0, 0, 0, 5, 0, 5, 0, 5, 0, 5, 0, 5, 7, 0, 0, 0, 7, 7, 7, 1,
-						4, 0, 6, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 5, 7, 0, 0, 0, 0, 0, 0, 8,
-						4, 0, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 7, 7, 1,
-						4, 0, 8, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 5, 7, 0, 0, 0, 0, 0, 0, 8,
-						4, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 5, 7, 0, 0, 0, 7, 7, 7, 1,
-						4, 0, 0, 0, 0, 0, 0, 5, 5, 5, 5, 0, 5, 5, 5, 5, 7, 7, 7, 7, 7, 7, 7, 1,
-						6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 0, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
-						8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4,
-						6, 6, 6, 6, 6, 6, 0, 6, 6, 6, 6, 0, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
-						4, 4, 4, 4, 4, 4, 0, 4, 4, 4, 6, 0, 6, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3,
-						4, 0, 0, 0, 0, 0, 0, 0, 0, 4, 6, 0, 6, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 2,
-						4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6, 2, 0, 0, 5, 0, 0, 2, 0, 0, 0, 2,
-						4, 0, 0, 0, 0, 0, 0, 0, 0, 4, 6, 0, 6, 2, 0, 0, 0, 0, 0, 2, 2, 0, 2, 2,
-						4, 0, 6, 0, 6, 0, 0, 0, 0, 4, 6, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 2,
-						4, 0, 0, 5, 0, 0, 0, 0, 0, 4, 6, 0, 6, 2, 0, 0, 0, 0, 0, 2, 2, 0, 2, 2,
-						4, 0, 6, 0, 6, 0, 0, 0, 0, 4, 6, 0, 6, 2, 0, 0, 5, 0, 0, 2, 0, 0, 0, 2,
-						4, 0, 0, 0, 0, 0, 0, 0, 0, 4, 6, 0, 6, 2, 0, 0, 0, 0, 0, 2, 0, 0, 0, 2,
-						4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 1, 1, 1, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3 };
-
-// how big the map is world space
-constexpr uint8_t MapWidth = 24;
-constexpr uint8_t MapHeight = 24;
-
 // how big each map grid is in pixels for the top view
 constexpr uint8_t MapPixelSize = 24;
 
-struct MapObject
-{
-	Vector2 Position;
-	float Facing = 0;
-
-	bool IsVissible = false;
-	float Distance = 0; // distance to the player, used to determine visibility
-};
+// how many cells across the top view shows
+constexpr int32_t TopViewCells = 24;
 
 std::vector <MapObject> MapObjects;
 
+// the objects sorted into areas of the map
+ObjectGrid ObjectBuckets;
+
 RenderTexture MapRenderTexture;	// render texture for the top view
-RenderTexture ViewRenderTexture; // render texture for the 3d view
 
 Texture2D WallTexture = { 0 };
 
 Texture2D SpriteTexture = { 0 };
 
-// 3d view size
+// CPU side copies of the textures for the software renderer
+SoftwareTexture WallTexels;
+SoftwareTexture SpriteTexels;
+
+// 3d view size, split screen views share this area
 constexpr uint16_t ViewWidth = 256 * 4;
 constexpr uint16_t ViewHeight = 192 * 4;
 
-constexpr float ViewFOV = 90 * DEG2RAD;
+// the views that are drawn each frame, the first one is the player and the rest are security cameras
+std::vector<RaycastView> Views;
+
+// the textures each view is drawn into on the GPU
+struct ViewTextures
+{
+	RenderTexture Render = { 0 };	// render texture for the 3d view
+	Texture2D Frame = { 0 };		// the software renderer's frame buffer is uploaded to this
+};
+
+std::vector<ViewTextures> ViewTargets;
+
+// how many views the 3d view area is split into, and where the security cameras are placed as a fraction of the map
+constexpr int MaxViews = 4;
+int ViewCount = 1;
+
+const Vector2 SecurityCameraSpots[MaxViews - 1] = { { 0.1f, 0.7f }, { 0.85f, 0.7f }, { 0.85f, 0.1f } };
 
 Vector2 PlayerPos = { 4.5f,  2.5f };
 Vector2 PlayerFacing = { 1, 0 };
@@ -97,211 +92,190 @@ Vector2 CameraPlane = { 0, -0.66f };	// the 2d equivalent of a camera plane, rot
 // flag to control if textures are used
 bool DrawFlatShaded = false;
 
-// used to know what side of a grid was hit
-enum class HitNormals : uint8_t
-{
-	North = 0,
-	South,
-	East,
-	West
-};
-
-// a ray that has been cast, with cached info
-struct RayResult
-{
-	// the ray's direction
-	Vector2 Directon = { 0 };
+// the textures in the wall set that the software renderer uses for the floor and ceiling
+constexpr int FloorTextureIndex = 7;
+constexpr int CeilingTextureIndex = 2;
 
-	// the distance to the cell hit
-	float Distance = 0;
+// flag to control if the view is drawn on the CPU into a frame buffer instead of with per column draw calls
+bool UseSoftwareRenderer = false;
 
-	// the side of the grid that was hit
-	HitNormals Normal;
+ThreadPool Workers;
 
-	// what kind of grid cell was hit
-	uint8_t HitGridType = 0;
-};
+// the cells with doors in them, and if the doors are opening or closing
+std::vector<size_t> DoorCells;
+bool DoorsOpen = false;
 
-// the rays that make up the view. This is a fixed size array based on the render view's width (one for each pixel in X)
-RayResult RaySet[ViewWidth] = { 0 };
+// how much of a door needs to be open for the player to fit through it
+constexpr uint8_t DoorPassableOpen = 192;
 
 
-// get the grid for map coordinate
-uint8_t GetMapGrid(uint8_t x, uint8_t y)
+// get the camera for the player's point of view
+RaycastCamera GetPlayerCamera()
 {
-	if (x >= MapWidth || y >= MapHeight)
-		return 0;
-
-	return MapData[y * MapWidth + x];
+	return RaycastCamera{ PlayerPos, PlayerFacing, CameraPlane };
 }
 
-uint8_t GetMapGrid(const Vector2& pos)
+// the columns and rows the 3d view area is split into for a number of views
+void GetViewGrid(int viewCount, int& columns, int& rows)
 {
-	return GetMapGrid(uint8_t(pos.x), uint8_t(pos.y));
+	columns = viewCount > 1 ? 2 : 1;
+	rows = viewCount > 2 ? 2 : 1;
 }
 
-// cast a ray and find out what it hits
-void CastRay(RayResult& ray)
+// set up the views for split screen, each view gets an even share of the 3d view area
+void SetupViews(int viewCount)
 {
-	ray.Distance = -1;
-
-	// The current grid point we are in
-	int mapX = int(floor(PlayerPos.x));
-	int mapY = int(floor(PlayerPos.y));
-
-	//length of ray from current position to next x or y-side
-	float sideDistX = 0;
-	float sideDistY = 0;
-
-	// length of ray from one x or y-side to next x or y-side
-	// these are derived as:
-	// deltaDistX = sqrt(1 + (rayDirY * rayDirY) / (rayDirX * rayDirX))
-	// deltaDistY = sqrt(1 + (rayDirX * rayDirX) / (rayDirY * rayDirY))
-	// which can be simplified to abs(|rayDir| / rayDirX) and abs(|rayDir| / rayDirY)
-	// where |rayDir| is the length of the vector (rayDirX, rayDirY). Its length,
-	// unlike (dirX, dirY) is not 1, however this does not matter, only the
-	// ratio between deltaDistX and deltaDistY matters, due to the way the DDA
-	// stepping further below works. So the values can be computed as below.
-	// Division through zero is prevented, even though technically that's not
-	// needed in C++ with IEEE 754 floating point values.
-	float deltaDistX = (ray.Directon.x == 0) ? float(1e30) : float(fabs(1.0f / ray.Directon.x));
-	float deltaDistY = (ray.Directon.y == 0) ? float(1e30) : float(fabs(1.0f / ray.Directon.y));
-
-	float perpWallDist = 0;
-
-	// what direction to step in x or y-direction (either +1 or -1)
-	int stepX = 0;
-	int stepY = 0;
-
-	bool hit = false; //was there a wall hit?
-	bool side = false; //was a NS or a EW wall hit?
-
-	// calculate step and initial sideDist
-	if (ray.Directon.x < 0)
-	{
-		stepX = -1;
-		sideDistX = (PlayerPos.x - mapX) * deltaDistX;
-	}
-	else
-	{
-		stepX = 1;
-		sideDistX = (mapX + 1.0f - PlayerPos.x) * deltaDistX;
-	}
+	int columns = 0;
+	int rows = 0;
+	GetViewGrid(viewCount, columns, rows);
 
-	if (ray.Directon.y < 0)
-	{
-		stepY = -1;
-		sideDistY = (PlayerPos.y - mapY) * deltaDistY;
-	}
-	else
-	{
-		stepY = 1;
-		sideDistY = (mapY + 1.0f - PlayerPos.y) * deltaDistY;
-	}
+	Views.resize(viewCount);
+	for (RaycastView& view : Views)
+		view.Resize(ViewWidth / columns, ViewHeight / rows);
 
-	// perform DDA Digital Differential Analyzer to walk the line
-	while (!hit)
+	// the security cameras sit at fixed spots in the map, or with the player if that spot is a wall
+	for (int i = 1; i < viewCount; i++)
 	{
-		//jump to next map square, either in x-direction, or in y-direction
-		if (sideDistX < sideDistY)
-		{
-			sideDistX += deltaDistX;
-			mapX += stepX;
-			side = false;
-		}
-		else
-		{
-			sideDistY += deltaDistY;
-			mapY += stepY;
-			side = true;
-		}
+		const Vector2& spot = SecurityCameraSpots[i - 1];
+		Vector2 position = { floorf(MapWidth * spot.x) + 0.5f, floorf(MapHeight * spot.y) + 0.5f };
 
-		if (mapX >= MapWidth || mapX < 0 || mapY >= MapHeight || mapY < 0)
-			break;
-
-		ray.HitGridType = GetMapGrid(mapX, mapY);
-
-		//Check if ray has hit a wall
-		if (ray.HitGridType != 0)
-			hit = true;
+		Views[i].Camera.Position = GetMapGrid(position) == 0 ? position : PlayerPos;
 	}
+}
 
-	if (!hit)
+// make the GPU textures for each view, this needs a window
+void LoadViewTextures()
+{
+	for (ViewTextures& target : ViewTargets)
 	{
-		ray.Distance = -1;
-		return;
+		UnloadRenderTexture(target.Render);
+		UnloadTexture(target.Frame);
 	}
 
+	ViewTargets.resize(Views.size());
 
-	// Calculate distance projected on camera direction. This is the shortest distance from the point where the wall is
-	// hit to the camera plane. Euclidean to center camera point would give fisheye effect!
-	// This can be computed as (mapX - posX + (1 - stepX) / 2) / rayDirX for side == 0, or same formula with Y
-	// for size == 1, but can be simplified to the code below thanks to how sideDist and deltaDist are computed:
-	// because they were left scaled to |rayDir|. sideDist is the entire length of the ray above after the multiple
-	// steps, but we subtract deltaDist once because one step more into the wall was taken above.
-	if (!side)
+	for (size_t i = 0; i < Views.size(); i++)
 	{
-		perpWallDist = (sideDistX - deltaDistX);
-		ray.Normal = stepX < 0 ? HitNormals::East : HitNormals::West;
-	}
-	else
-	{
-		perpWallDist = (sideDistY - deltaDistY);
-		ray.Normal = stepY < 0 ? HitNormals::North : HitNormals::South;
-	}
+		ViewTargets[i].Render = LoadRenderTexture(Views[i].GetWidth(), Views[i].GetHeight());
 
-	ray.Distance = perpWallDist;
+		Image frameImage = GenImageColor(Views[i].GetWidth(), Views[i].GetHeight(), BLACK);
+		ViewTargets[i].Frame = LoadTextureFromImage(frameImage);
+		UnloadImage(frameImage);
+	}
 }
 
-// compute the rays for the current view
-void UpdateRayset()
+// point the cameras and compute the rays for every view
+// this is where the raycasting happens, the views are split into bands of columns that are cast in parallel
+void UpdateViews()
 {
-	for (uint16_t i = 0; i < ViewWidth; i++)
-	{
-		RayResult& ray = RaySet[i];
+	Views[0].Camera = GetPlayerCamera();
 
-		float cameraX = 2 * i / (float)ViewWidth - 1; //x-coordinate in camera space
-		ray.Directon.x = PlayerFacing.x + CameraPlane.x * cameraX;
-		ray.Directon.y = PlayerFacing.y + CameraPlane.y * cameraX;
+	// the security cameras slowly look around
+	float sweep = 90.0f * DEG2RAD * sinf(float(GetTime()) * 0.3f);
 
-		CastRay(ray);
+	for (size_t i = 1; i < Views.size(); i++)
+	{
+		float angle = sweep + i * 90.0f * DEG2RAD;
+		Views[i].Camera.Facing = Vector2Rotate(Vector2{ 1, 0 }, angle);
+		Views[i].Camera.Plane = Vector2Rotate(Vector2{ 0, -0.66f }, angle);
 	}
+
+	CastViews(Views, Workers);
 }
 
-// draw the rays in the top view
-void DrawRayset(const Vector2& playerPos, float scale)
+// draw the walls, floor, ceiling and objects of every view into their frame buffers
+// each band of columns is drawn by one worker, and the bands don't share any pixels
+void DrawViewsSoftware()
 {
-	for (uint16_t i = 0; i < ViewWidth; i++)
-	{
-		RayResult& ray = RaySet[i];
+	SoftwareScene scene;
+	scene.Walls = &WallTexels;
+	scene.Sprite = &SpriteTexels;
+	scene.FloorTexture = FloorTextureIndex;
+	scene.CeilingTexture = CeilingTextureIndex;
+	scene.FlatShaded = DrawFlatShaded;
+
+	DrawViews(Views, scene, Workers);
+}
 
+// draw the rays of a view in the top view
+void DrawRayset(const RaycastView& view, const Vector2& playerPos, float scale)
+{
+	for (const RayResult& ray : view.Rays)
+	{
 		if (ray.Distance >= 0)
 			DrawLineV(playerPos, Vector2Add(playerPos, Vector2Scale(ray.Directon, ray.Distance * scale)), ColorAlpha(GREEN, 0.5f));
 	}
 }
 
+// the first cell shown in the top view, the view follows the player on maps that are bigger than it
+void GetTopViewOrigin(int32_t& originX, int32_t& originY)
+{
+	originX = std::clamp(int32_t(floorf(PlayerPos.x)) - TopViewCells / 2, 0, std::max(MapWidth - TopViewCells, 0));
+	originY = std::clamp(int32_t(floorf(PlayerPos.y)) - TopViewCells / 2, 0, std::max(MapHeight - TopViewCells, 0));
+}
+
 void DrawMapTopView()
 {
 	BeginTextureMode(MapRenderTexture);
 	ClearBackground(DARKGRAY);
 
+	int32_t originX = 0;
+	int32_t originY = 0;
+	GetTopViewOrigin(originX, originY);
+
 	// fill the map with cells
-	for (uint8_t y = 0; y < MapHeight; y++)
+	for (int32_t y = 0; y < std::min(TopViewCells, MapHeight); y++)
 	{
-		for (uint8_t x = 0; x < MapWidth; x++)
+		for (int32_t x = 0; x < std::min(TopViewCells, MapWidth); x++)
 		{
-			if (GetMapGrid(x, y) != 0)
+			if (GetMapGrid(originX + x, originY + y) != 0)
 			{
-				DrawRectangle(x * MapPixelSize, y * MapPixelSize, MapPixelSize, MapPixelSize, WHITE);
+				uint8_t flags = GetMapFlags(originX + x, originY + y);
+
+				// short walls are a lighter color
+				Color color = GetMapHeight(originX + x, originY + y) < FullWallHeight ? LIGHTGRAY : WHITE;
+
+				if (flags & (CellFlagDoor | CellFlagThinWall))
+				{
+					// thin walls and doors are a line through the middle of the cell, doors show how far they are open
+					float open = 0;
+					if (flags & CellFlagDoor)
+					{
+						open = MapDoorOpen[GetMapIndex(originX + x, originY + y)] / 255.0f;
+						color = ORANGE;
+					}
+
+					Vector2 center = { (x + 0.5f) * MapPixelSize, (y + 0.5f) * MapPixelSize };
+					if (flags & CellFlagAlongX)
+						DrawLineEx(Vector2{ (x + open) * MapPixelSize, center.y }, Vector2{ float(x + 1) * MapPixelSize, center.y }, 3, color);
+					else
+						DrawLineEx(Vector2{ center.x, (y + open) * MapPixelSize }, Vector2{ center.x, float(y + 1) * MapPixelSize }, 3, color);
+				}
+				else
+				{
+					DrawRectangle(x * MapPixelSize, y * MapPixelSize, MapPixelSize, MapPixelSize, color);
+				}
 			}
 			DrawRectangleLines(x * MapPixelSize, y * MapPixelSize, MapPixelSize, MapPixelSize, BLACK);
 		}
 	}
 
-	Vector2 playerPixelSpace = Vector2Scale(PlayerPos, MapPixelSize);
+	Vector2 viewOrigin = { float(originX), float(originY) };
+
+	Vector2 playerPixelSpace = Vector2Scale(Vector2Subtract(PlayerPos, viewOrigin), MapPixelSize);
 
 	// draw rays
-	DrawRayset(playerPixelSpace, MapPixelSize);
+	DrawRayset(Views[0], playerPixelSpace, MapPixelSize);
+
+	// draw the security cameras and which way they look
+	for (size_t i = 1; i < Views.size(); i++)
+	{
+		const RaycastCamera& camera = Views[i].Camera;
+		Vector2 cameraPixelSpace = Vector2Scale(Vector2Subtract(camera.Position, viewOrigin), MapPixelSize);
+
+		DrawCircleV(cameraPixelSpace, MapPixelSize * 0.25f, MAGENTA);
+		DrawLineV(cameraPixelSpace, Vector2Add(cameraPixelSpace, Vector2Scale(camera.Facing, MapPixelSize)), PINK);
+	}
 
 	// draw player
 	DrawCircleV(playerPixelSpace, MapPixelSize * 0.25f, BLUE);
@@ -315,158 +289,183 @@ void DrawMapTopView()
 	DrawLine(MapPixelSize / 4, MapPixelSize / 4, MapPixelSize, MapPixelSize / 4, RED);
 	DrawLine(MapPixelSize / 4, MapPixelSize / 4, MapPixelSize / 4, MapPixelSize, GREEN);
 
-	// draw objects
-	for (const MapObject& obj : MapObjects)
-	{
-		Vector2 objPixelSpace = Vector2Scale(obj.Position, MapPixelSize);
-		DrawCircleV(objPixelSpace, MapPixelSize * 0.25f, obj.IsVissible ? YELLOW : DARKBLUE);
-		DrawLineV(objPixelSpace, Vector2Add(objPixelSpace, Vector2Scale(Vector2Rotate(Vector2UnitX, obj.Facing * DEG2RAD), MapPixelSize * 0.5f)), ORANGE);
-	}
+	// draw the objects that are in the top view
+	ObjectBuckets.ForEachInArea(viewOrigin.x - 1, viewOrigin.y - 1, viewOrigin.x + TopViewCells + 1, viewOrigin.y + TopViewCells + 1, [&viewOrigin](uint32_t index)
+		{
+			const MapObject& obj = MapObjects[index];
+
+			Vector2 objPixelSpace = Vector2Scale(Vector2Subtract(obj.Position, viewOrigin), MapPixelSize);
+			DrawCircleV(objPixelSpace, MapPixelSize * 0.25f, obj.IsVissible ? YELLOW : DARKBLUE);
+			DrawLineV(objPixelSpace, Vector2Add(objPixelSpace, Vector2Scale(Vector2Rotate(Vector2UnitX, obj.Facing * DEG2RAD), MapPixelSize * 0.5f)), ORANGE);
+		});
 
 	EndTextureMode();
 }
 
-// figure out how far from the edge of a cell the current ray is
-float GetRayU(const RayResult& ray)
+// draw the visible objects of a view with the GPU
+// each run of columns where an object is in front of the walls is one quad, instead of one quad per column
+void DrawObjects(const RaycastView& view)
 {
-	Vector2 target = Vector2Add(PlayerPos, Vector2Scale(ray.Directon, ray.Distance));
+	float frameWidth = float(SpriteTexture.height);
+	const RayResult* rays = view.Rays.data();
 
-	switch (ray.Normal)
+	for (const ObjectSpan& span : view.Objects.Spans)
 	{
-	case HitNormals::South:
-		return  target.x - floorf(target.x);
+		float texStep = frameWidth / span.Size;
+		float frameStart = span.Frame * frameWidth;
 
-	case HitNormals::North:
-		return  1.0f - (target.x - floorf(target.x));
+		int column = span.StartColumn;
+		while (column < span.EndColumn)
+		{
+			// skip the columns where a wall is in front, rays that missed are infinitely far away
+			while (column < span.EndColumn && rays[column].Distance >= 0 && rays[column].Distance <= span.Depth)
+				column++;
 
-	case HitNormals::East:
-		return  target.y - floorf(target.y);
+			int runStart = column;
+			while (column < span.EndColumn && (rays[column].Distance < 0 || rays[column].Distance > span.Depth))
+				column++;
 
-	case HitNormals::West:
-		return  1.0f - (target.y - floorf(target.y));
-	}
+			if (column == runStart)
+				continue;
 
-	return 0;
+			Rectangle sourceRect = { frameStart + (runStart - span.Left) * texStep, 0, (column - runStart) * texStep, frameWidth };
+			Rectangle destRect = { float(runStart), float(span.Top), float(column - runStart), float(span.Size) };
+			DrawTexturePro(SpriteTexture, sourceRect, destRect, Vector2Zeros, 0, WHITE);
+		}
+	}
 }
 
-void DrawObjects()
+// draw one wall hit in a column, short walls stand on the floor and lose rows off the top
+void DrawWallColumnGPU(const RaycastView& view, int column, float distance, float u, HitNormals normal, uint8_t type, uint8_t height)
 {
-	float invDet = 1.0f / (CameraPlane.x * PlayerFacing.y - PlayerFacing.x * CameraPlane.y); //required for correct matrix multiplication
-
-	float frameWidth = SpriteTexture.height;
-
-	for (MapObject& obj : MapObjects)
-	{
-		if (!obj.IsVissible)
-			continue;
-
-		Vector2 relativePos = Vector2Subtract(obj.Position, PlayerPos);
+	// the middle of the screen
+	int middle = view.GetHeight() / 2;
 
-		float relativeAngle = atan2f(relativePos.y, relativePos.x) * RAD2DEG - 45;
+	// use the distance to compute how high the wall will be
+	int lineHeight = (int)(view.GetHeight() / distance);
+	float visible = height / float(FullWallHeight);
 
-        float spriteStartX = frameWidth * floor(fmodf(obj.Facing - relativeAngle, 360.0f) / 90.0f);
+	// get our tint based on what side of a grid the ray hit
+	Color tint = WallColors[uint8_t(normal)];
 
-		float transformX = invDet * (PlayerFacing.y * relativePos.x - PlayerFacing.x * relativePos.y);
-		float transformY = invDet * (-CameraPlane.y * relativePos.x + CameraPlane.x * relativePos.y); //this is actually the depth inside the screen, that what Z is in 3D
+	if (DrawFlatShaded || WallTexture.id == 0)
+	{
+		// draw a line up from the bottom of the wall for this X column
+		DrawLine(column, int(middle + lineHeight / 2 - lineHeight * visible), column, middle + lineHeight / 2, tint);
+	}
+	else
+	{
+		// find the start of the texture for this grid type
+		float uStart = WallTexture.height * (type - 1.0f);
 
-		int spriteScreenX = int((ViewWidth / 2) * (1 + transformX / transformY));
+		// compute a source rect for a single strip of texture we want to draw for this pixel, short walls show the bottom of it
+		Rectangle sourceRect{ uStart + (u * WallTexture.height), WallTexture.height * (1 - visible), 0, WallTexture.height * visible };
 
-		int spriteHeight = abs(int(ViewRenderTexture.texture.height / (transformY))); //using 'transformY' instead of the real distance prevents fisheye
+		// compute where on the screen this column is going to be drawn
+		Rectangle destRect{ float(column), middle + lineHeight / 2.0f - lineHeight * visible, 1.0f,  lineHeight * visible };
 
-		//calculate lowest and highest pixel to fill in current stripe
-		int drawStartY = -spriteHeight / 2 + ViewRenderTexture.texture.height / 2;
-		if (drawStartY < 0)
-			drawStartY = 0;
-		int drawEndY = spriteHeight / 2 + ViewRenderTexture.texture.height / 2;
-		if (drawEndY >= ViewRenderTexture.texture.height)
-			drawEndY = ViewRenderTexture.texture.height - 1;
+		DrawTexturePro(WallTexture, sourceRect, destRect, Vector2Zero(), 0, tint);
+	}
+}
 
-		//calculate width of the sprite
-		int spriteWidth = abs(int(ViewRenderTexture.texture.height / (transformY)));
-		int drawStartX = -spriteWidth / 2 + spriteScreenX;
-		if (drawStartX < 0)
-			drawStartX = 0;
-		int drawEndX = spriteWidth / 2 + spriteScreenX;
-		if (drawEndX >= ViewWidth)
-			drawEndX = ViewWidth - 1;
+// draw the short walls a column sees over, back to front, starting with the first layer
+void DrawWallLayersGPU(const RaycastView& view, int column, int firstLayer)
+{
+	const RayResult& ray = view.Rays[column];
 
-		//loop through every vertical stripe of the sprite on screen
-		for (int stripe = drawStartX; stripe < drawEndX; stripe++)
-		{
-			int texX = int(256 * (stripe - (-spriteWidth / 2 + spriteScreenX)) * frameWidth / spriteWidth) / 256;
-			//the conditions in the if are:
-			//1) it's in front of camera plane so you don't see things behind you
-			//2) it's on the screen (left)
-			//3) it's on the screen (right)
-			//4) ZBuffer, with perpendicular distance
-			if (transformY > 0 && stripe > 0 && stripe < ViewWidth && transformY < RaySet[stripe].Distance)
-			{
-				Rectangle sourceRect = { float(texX + spriteStartX), 0, 1, float(SpriteTexture.height) };
-				Rectangle destRect = { float(stripe), float(drawStartY), 1, float(drawEndY - drawStartY) };
-				DrawTexturePro(SpriteTexture, sourceRect, destRect, Vector2Zeros, 0, WHITE);
-			}
-		}
+	for (int layer = firstLayer; layer >= 0; layer--)
+	{
+		const RayLayer& wall = ray.Layers[layer];
+		DrawWallColumnGPU(view, column, wall.Distance, wall.U, wall.Normal, wall.HitGridType, wall.Height);
 	}
 }
 
-
-// draw the 3d view
-void DrawView()
+// draw the walls, floor and ceiling of a view with one draw call per column
+void DrawViewColumnsGPU(const RaycastView& view)
 {
-	BeginTextureMode(ViewRenderTexture);
-
 	// fill the texture with the ceiling color
-	ClearBackground(DARKGRAY);
+	ClearBackground(CeilingColor);
 
 	// the middle of the screen
-	int middle = ViewRenderTexture.texture.height / 2;
+	int middle = view.GetHeight() / 2;
 
 	// fill half the screen with the ground color
-	DrawRectangle(0, middle, ViewRenderTexture.texture.width, middle, DARKBROWN);
-
-	// an array of colors to use to tint each wall a different color based on direction
-	static Color wallColors[4] = { WHITE, Color{128,128,128,255}, Color{196,196,196,255} , Color{200,200,200,255} };
+	DrawRectangle(0, middle, view.GetWidth(), middle, FloorColor);
 
 	// for each ray in our rayset
-	for (uint16_t i = 0; i < ViewWidth; i++)
+	for (int i = 0; i < view.GetWidth(); i++)
 	{
-		const RayResult& ray = RaySet[i];
+		const RayResult& ray = view.Rays[i];
 
-		if (ray.Distance < 0)
-			continue;
+		if (ray.Distance >= 0)
+			DrawWallColumnGPU(view, i, ray.Distance, ray.U, ray.Normal, ray.HitGridType, FullWallHeight);
 
-		// use the distance to compute how high the wall will be
-		int lineHeight = (int)(ViewRenderTexture.texture.height / ray.Distance);
+		DrawWallLayersGPU(view, i, ray.LayerCount - 1);
+	}
+}
 
-		// get our tint based on what side of a grid the ray hit
-		Color tint = wallColors[uint8_t(ray.Normal)];
+// objects are only clipped by the full walls, so draw the short walls that are in front of the nearest object again
+// this is right when there is one object in a column, with more than one an object between two short walls can show
+// over the far one
+void DrawWallLayersOverObjects(const RaycastView& view)
+{
+	std::vector<float> nearestObject(view.GetWidth(), FLT_MAX);
 
-		if (DrawFlatShaded || WallTexture.id == 0)
-		{
-			// draw a line from the center for this X column 
-			DrawLine(i, middle - lineHeight / 2, i, middle + lineHeight / 2, tint);
-		}
-		else
-		{
-			// get the U coordinate of this ray (where on the texture it hits in x)
-			float u = GetRayU(ray);
+	for (const ObjectSpan& span : view.Objects.Spans)
+	{
+		for (int column = span.StartColumn; column < span.EndColumn; column++)
+			nearestObject[column] = std::min(nearestObject[column], span.Depth);
+	}
 
-			// find the start of the texture for this grid type
-			float uStart = WallTexture.height * (ray.HitGridType - 1.0f);
+	for (int i = 0; i < view.GetWidth(); i++)
+	{
+		const RayResult& ray = view.Rays[i];
 
-			// compute a source rect for a single strip of texture we want to draw for this pixel
-			Rectangle sourceRect{ uStart + (u * WallTexture.height), 0, 0, float(WallTexture.height) };
+		int firstLayer = -1;
+		while (firstLayer + 1 < ray.LayerCount && ray.Layers[firstLayer + 1].Distance < nearestObject[i])
+			firstLayer++;
 
-			// compute where on the screen this column is going to be drawn
-			Rectangle destRect{ float(i), middle - lineHeight / 2.0f, 1.0f,  float(lineHeight) };
+		DrawWallLayersGPU(view, i, firstLayer);
+	}
+}
 
-			DrawTexturePro(WallTexture, sourceRect, destRect, Vector2Zero(), 0, tint);
+// draw the 3d view of every view to it's render texture
+void DrawViews()
+{
+	for (size_t i = 0; i < Views.size(); i++)
+	{
+		const RaycastView& view = Views[i];
+		ViewTextures& target = ViewTargets[i];
+
+		BeginTextureMode(target.Render);
+
+		if (UseSoftwareRenderer)
+		{
+			// the workers already drew the frame buffer, so upload it all at once
+			UpdateTexture(target.Frame, view.Frame.Pixels.data());
+			DrawTexture(target.Frame, 0, 0, WHITE);
+		}
+		else
+		{
+			DrawViewColumnsGPU(view);
+			DrawObjects(view);
+			DrawWallLayersOverObjects(view);
 		}
+
+		EndTextureMode();
 	}
+}
 
-	DrawObjects();
+// the player can walk into open cells and through doors that are open far enough
+bool CanMoveTo(const Vector2& pos)
+{
+	int32_t x = int32_t(floorf(pos.x));
+	int32_t y = int32_t(floorf(pos.y));
 
-	EndTextureMode();
+	if (GetMapGrid(x, y) == 0)
+		return true;
+
+	return (GetMapFlags(x, y) & CellFlagDoor) && MapDoorOpen[GetMapIndex(x, y)] >= DoorPassableOpen;
 }
 
 // move the player around the map
@@ -512,10 +511,35 @@ void UpdateMovement()
 		newPos = Vector2Add(newPos, Vector2Scale(sideStepVector, -movementSpeed));
 
 	// if the new pos is not inside the world, allow the player to move there
-	if (GetMapGrid(newPos) == 0)
+	if (CanMoveTo(newPos))
 		PlayerPos = newPos;
 }
 
+// find all the doors in the map, so they can be opened and closed without looking at every cell
+void FindDoors()
+{
+	DoorCells.clear();
+
+	size_t cellCount = size_t(MapWidth) * size_t(MapHeight);
+	for (size_t i = 0; i < cellCount; i++)
+	{
+		if (MapData[i] != 0 && (MapFlags[i] & CellFlagDoor))
+			DoorCells.push_back(i);
+	}
+}
+
+// slide the doors towards open or closed
+void UpdateDoors()
+{
+	int speed = std::max(int(255 * GetFrameTime()), 1);
+
+	for (size_t index : DoorCells)
+	{
+		int open = MapDoorOpen[index];
+		MapDoorOpen[index] = uint8_t(DoorsOpen ? std::min(open + speed, 255) : std::max(open - speed, 0));
+	}
+}
+
 void InitObjects()
 {
 	MapObjects.push_back(MapObject{ Vector2{10.5f,9.5f}, 0 });
@@ -525,48 +549,158 @@ void InitObjects()
 	MapObjects.push_back(MapObject{ Vector2{10.5f,4.0f}, 90 });
 }
 
-void ComputeObjectVisibility()
+// move the objects around so they are not just standing there
+void MoveObjects()
 {
-	// compute the visibility of each object
 	for (MapObject& obj : MapObjects)
 	{
-        obj.Position.x += sinf(GetTime()) * GetFrameTime();
-        obj.Position.y += cos(GetTime()) * GetFrameTime();
+		obj.Position.x += sinf(GetTime()) * GetFrameTime();
+		obj.Position.y += cos(GetTime()) * GetFrameTime();
+	}
+}
 
+// add objects at random open cells, to see how the renderer handles a crowd
+void AddObjects(int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		Vector2 position = { float(GetRandomValue(0, MapWidth - 1)) + 0.5f, float(GetRandomValue(0, MapHeight - 1)) + 0.5f };
+		if (GetMapGrid(position) != 0)
+			continue;
+
+		MapObjects.push_back(MapObject{ position, float(GetRandomValue(0, 359)) });
+	}
+}
+
+// find the objects that can be seen from each view and where they are on screen
+// this uses the rays to skip objects that are behind walls, so the rays need to be cast first
+void ComputeObjectVisibility()
+{
+	ObjectBuckets.Build(MapObjects);
+	FindViewObjects(Views, MapObjects, ObjectBuckets, SpriteTexels.Height > 0 ? SpriteTexels.Width / SpriteTexels.Height : 0, Workers);
+
+	// flag the objects the player can see for the top view
+	for (MapObject& obj : MapObjects)
 		obj.IsVissible = false;
-		// compute the vector to the object
-		Vector2 toObj = Vector2Subtract(obj.Position, PlayerPos);
-		// compute the angle to the object
-		float angleToObj = Vector2Angle(PlayerFacing, toObj);
-		// if the angle is within 45 degrees, then it is visible
-		if (fabsf(angleToObj) < ViewFOV / 2.0f)
-			obj.IsVissible = true;
-
-		if (obj.IsVissible)
-		{
-			// compute the distance to the object
-			obj.Distance = Vector2Distance(PlayerPos, obj.Position);
 
-			if (obj.Distance < 1.0f)
-				obj.IsVissible = false; // don't allow objects to be too close
-		}
+	for (const ObjectSpan& span : Views[0].Objects.Spans)
+	{
+		MapObjects[span.Object].IsVissible = true;
+		MapObjects[span.Object].Distance = span.Depth;
 	}
+}
+
+// load the CPU side copies of the wall and sprite textures for the software renderer
+void LoadSoftwareTextures(Image wallImage, Image spriteImage)
+{
+	WallTexels.Load(wallImage);
+	SpriteTexels.Load(spriteImage);
+}
 
-	std::qsort(MapObjects.data(), MapObjects.size(), sizeof(MapObject), [](const void* a, const void* b) -> int
+// render a single frame with the software renderer and save it, without opening a window
+// this makes it easy to check the renderer by comparing the images it makes
+int RenderHeadless(const char* fileName)
+{
+	InitObjects();
+
+	Image wallImage = LoadImage("resources/textures.png");
+	Image spriteImage = LoadImage("resources/sprite.png");
+	LoadSoftwareTextures(wallImage, spriteImage);
+	UnloadImage(wallImage);
+	UnloadImage(spriteImage);
+
+	SetupViews(1);
+
+	UpdateViews();
+	ComputeObjectVisibility();
+	DrawViewsSoftware();
+
+	return ExportFrameBuffer(Views[0].Frame, fileName) ? 0 : 1;
+}
+
+// run the benchmark with the same view size and textures as the demo, without opening a window
+int RunBenchmark(BenchmarkOptions& options)
+{
+	Image wallImage = LoadImage("resources/textures.png");
+	Image spriteImage = LoadImage("resources/sprite.png");
+	LoadSoftwareTextures(wallImage, spriteImage);
+	UnloadImage(wallImage);
+	UnloadImage(spriteImage);
+
+	options.ViewWidth = ViewWidth;
+	options.ViewHeight = ViewHeight;
+	options.Walls = &WallTexels;
+	options.Sprite = &SpriteTexels;
+	options.FloorTexture = FloorTextureIndex;
+	options.CeilingTexture = CeilingTextureIndex;
+
+	return RunRaycastBenchmark(options, Workers) == 0 ? 0 : 1;
+}
+
+// make sure the player starts in an open cell, a loaded map may have a wall where the default start is
+void PlacePlayer()
+{
+	if (IsInMap(int32_t(PlayerPos.x), int32_t(PlayerPos.y)) && GetMapGrid(PlayerPos) == 0)
+		return;
+
+	for (int32_t y = 0; y < MapHeight; y++)
+	{
+		for (int32_t x = 0; x < MapWidth; x++)
 		{
-			const MapObject* objA = static_cast<const MapObject*>(a);
-			const MapObject* objB = static_cast<const MapObject*>(b);
-			if (objA->Distance < objB->Distance)
-				return 1;
-			else if (objA->Distance > objB->Distance)
-				return -1;
-			else
-				return 0;
-		});
+			if (GetMapGrid(x, y) == 0)
+			{
+				PlayerPos = Vector2{ x + 0.5f, y + 0.5f };
+				return;
+			}
+		}
+	}
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+	const char* mapFile = nullptr;
+	const char* renderFile = nullptr;
+	bool benchmark = false;
+	BenchmarkOptions benchmarkOptions;
+
+	// --map <file> loads a binary map file instead of the built in map
+	// --render <file> draws one frame with the software renderer and saves it to a file
+	// --bench runs the benchmark without opening a window
+	// --fixed starts with 16.16 fixed point ray math, so the benchmark checks the fixed point golden images
+	// --golden <folder> runs the benchmark and checks frames against the golden images in a folder
+	// --save-golden <folder> runs the benchmark and saves the golden images to a folder
+	for (int i = 1; i < argc; i++)
+	{
+		if (TextIsEqual(argv[i], "--bench"))
+			benchmark = true;
+		else if (TextIsEqual(argv[i], "--fixed"))
+			UseFixedPointDDA = true;
+		else if (i + 1 >= argc)
+			break;
+		else if (TextIsEqual(argv[i], "--map"))
+			mapFile = argv[++i];
+		else if (TextIsEqual(argv[i], "--render"))
+			renderFile = argv[++i];
+		else if (TextIsEqual(argv[i], "--golden") || TextIsEqual(argv[i], "--save-golden"))
+		{
+			benchmark = true;
+			benchmarkOptions.SaveGolden = TextIsEqual(argv[i], "--save-golden");
+			benchmarkOptions.GoldenFolder = argv[++i];
+		}
+	}
+
+	if (mapFile == nullptr || !LoadMap(mapFile))
+		LoadDefaultMap();
+
+	PlacePlayer();
+	FindDoors();
+
+	if (benchmark)
+		return RunBenchmark(benchmarkOptions);
+
+	if (renderFile != nullptr)
+		return RenderHeadless(renderFile);
+
 	// set up the window
 	//SetConfigFlags(FLAG_VSYNC_HINT);
 	InitWindow(1800, 900, "Raycaster Example");
@@ -574,13 +708,22 @@ int main()
 
 	InitObjects();
 
-	// load render textures for the top view and 3d view
-	MapRenderTexture = LoadRenderTexture(MapWidth * MapPixelSize, MapHeight * MapPixelSize);
-	ViewRenderTexture = LoadRenderTexture(ViewWidth, ViewHeight);
+	// load render textures for the top view and 3d views
+	MapRenderTexture = LoadRenderTexture(TopViewCells * MapPixelSize, TopViewCells * MapPixelSize);
+
+	SetupViews(ViewCount);
+	LoadViewTextures();
+
+	// textures for our walls and objects, the images are kept on the CPU for the software renderer
+	Image wallImage = LoadImage("resources/textures.png");
+	Image spriteImage = LoadImage("resources/sprite.png");
+
+	WallTexture = LoadTextureFromImage(wallImage);
+	SpriteTexture = LoadTextureFromImage(spriteImage);
+	LoadSoftwareTextures(wallImage, spriteImage);
 
-	// textures for our walls
-	WallTexture = LoadTexture("resources/textures.png");
-	SpriteTexture = LoadTexture("resources/Sprite.png");
+	UnloadImage(wallImage);
+	UnloadImage(spriteImage);
 
 	GenTextureMipmaps(&WallTexture);
 	SetTextureFilter(WallTexture, TEXTURE_FILTER_TRILINEAR);
@@ -592,21 +735,55 @@ int main()
 		if (IsKeyPressed(KEY_SPACE))
 			DrawFlatShaded = !DrawFlatShaded;
 
-		// move the player
+		// let the user toggle the software renderer
+		if (IsKeyPressed(KEY_R))
+			UseSoftwareRenderer = !UseSoftwareRenderer;
+
+		// let the user toggle jumping over empty space, the view is the same either way
+		if (IsKeyPressed(KEY_K))
+			SkipEmptySpace = !SkipEmptySpace;
+
+		// let the user add a crowd of objects
+		if (IsKeyPressed(KEY_O))
+			AddObjects(1000);
+
+		// let the user split the screen between the player and security cameras
+		if (IsKeyPressed(KEY_V))
+		{
+			ViewCount = ViewCount == 1 ? 2 : (ViewCount == 2 ? MaxViews : 1);
+			SetupViews(ViewCount);
+			LoadViewTextures();
+		}
+
+		// let the user toggle the fixed point ray caster
+		if (IsKeyPressed(KEY_I))
+			UseFixedPointDDA = !UseFixedPointDDA;
+
+		// let the user open and close the doors
+		if (IsKeyPressed(KEY_F))
+			DoorsOpen = !DoorsOpen;
+
+		// move the player, the objects and the doors
 		UpdateMovement();
+		MoveObjects();
+		UpdateDoors();
 
-		// compute the rays for the current view
+		// compute the rays for the current views
 		// this is where the raycasting happens
-		UpdateRayset();
+		UpdateViews();
 
-		// figure out what objects may be visible
+		// figure out what objects are visible, the rays tell us which ones are behind walls
 		ComputeObjectVisibility();
 
+		// the software renderer draws the whole view on the CPU, the workers fill in the frame buffers
+		if (UseSoftwareRenderer)
+			DrawViewsSoftware();
+
 		// update the top view render texture
 		DrawMapTopView();
 
-		// draw the 3d view to it's low res render texture
-		DrawView();
+		// draw the 3d views to their low res render textures
+		DrawViews();
 
 
 		// Draw the results to the screen
@@ -634,20 +811,49 @@ int main()
 		// center the texture in the view area
 		Rectangle destRect = { viewArea.x + viewArea.width / 2 - renderWidth / 2, viewArea.height / 2 - renderHeight / 2, renderWidth,renderHeight };
 
-		DrawTexturePro(ViewRenderTexture.texture, Rectangle{ 0,0,ViewWidth, -ViewHeight }, destRect, Vector2Zero(), 0, WHITE);
+		// each view gets it's own part of the 3d view area
+		int viewColumns = 0;
+		int viewRows = 0;
+		GetViewGrid(int(Views.size()), viewColumns, viewRows);
+
+		for (size_t i = 0; i < Views.size(); i++)
+		{
+			const RaycastView& view = Views[i];
+
+			float viewWidth = destRect.width / viewColumns;
+			float viewHeight = destRect.height / viewRows;
+			Rectangle viewRect = { destRect.x + (i % viewColumns) * viewWidth, destRect.y + (i / viewColumns) * viewHeight, viewWidth, viewHeight };
+
+			DrawTexturePro(ViewTargets[i].Render.texture, Rectangle{ 0, 0, float(view.GetWidth()), -float(view.GetHeight()) }, viewRect, Vector2Zero(), 0, WHITE);
+		}
 
 		// text overlay
 		DrawFPS(2, 0);
 		DrawText(TextFormat("Player X%2.1f, X%2.1f", PlayerPos.x, PlayerPos.y), 2, 20, 20, WHITE);
 		DrawText("Space to toggle shaded vs textures", 2, 40, 20, WHITE);
+		if (UseSoftwareRenderer)
+			DrawText(TextFormat("R to toggle renderer (software, %d threads)", int(Workers.GetThreadCount())), 2, 60, 20, WHITE);
+		else
+			DrawText("R to toggle renderer (GPU)", 2, 60, 20, WHITE);
+		DrawText(SkipEmptySpace ? "K to toggle empty space skipping (on)" : "K to toggle empty space skipping (off)", 2, 80, 20, WHITE);
+		DrawText(TextFormat("O to add objects (%d objects, %d visible)", int(MapObjects.size()), int(Views[0].Objects.Spans.size())), 2, 100, 20, WHITE);
+		DrawText(DoorsOpen ? "F to close the doors" : "F to open the doors", 2, 120, 20, WHITE);
+		DrawText(UseFixedPointDDA ? "I to toggle the ray math (16.16 fixed point)" : "I to toggle the ray math (float)", 2, 140, 20, WHITE);
+		DrawText(TextFormat("V to split the screen (%d views)", int(Views.size())), 2, 160, 20, WHITE);
 
 		EndDrawing();
 	}
 
 	// cleanup
 	UnloadTexture(WallTexture);
+	UnloadTexture(SpriteTexture);
 	UnloadRenderTexture(MapRenderTexture);
-	UnloadRenderTexture(ViewRenderTexture);
+
+	for (ViewTextures& target : ViewTargets)
+	{
+		UnloadRenderTexture(target.Render);
+		UnloadTexture(target.Frame);
+	}
 
 	CloseWindow();
 	return 0;
@@ -0,0 +1,460 @@
+/*
+*   Raylib software Raycaster
+*   Based on algorithms from
+*   https://lodev.org/cgtutor/raycasting.html
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-extras are licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2025 Jeffery Myers (jeffm)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "software_renderer.h"
+
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef RAYCAST_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// an array of colors to use to tint each wall a different color based on direction
+const Color WallColors[4] = { WHITE, Color{128,128,128,255}, Color{196,196,196,255} , Color{200,200,200,255} };
+
+void FrameBuffer::Resize(int width, int height)
+{
+	Width = width;
+	Height = height;
+	Pixels.resize(size_t(width) * height);
+}
+
+void SoftwareTexture::Load(Image image)
+{
+	Width = image.width;
+	Height = image.height;
+	Texels.resize(size_t(Width) * Height);
+
+	// flip the rows into columns
+	Color* colors = LoadImageColors(image);
+
+	for (int y = 0; y < Height; y++)
+	{
+		for (int x = 0; x < Width; x++)
+			Texels[size_t(x) * Height + y] = colors[size_t(y) * Width + x];
+	}
+
+	UnloadImageColors(colors);
+}
+
+void ViewColumnTable::Build(int width)
+{
+	if (width == Width)
+		return;
+
+	Width = width;
+	CameraX.resize(width);
+
+	for (int i = 0; i < width; i++)
+		CameraX[i] = 2 * i / (float)width - 1; //x-coordinate in camera space
+}
+
+void ViewWallColumns::Resize(int width)
+{
+	Walls.resize(width);
+	Layers.resize(size_t(width) * MaxRayLayers);
+	LayerCounts.resize(width);
+}
+
+void CastViewColumns(const RaycastCamera& camera, const ViewColumnTable& columns, RayResult* rays, int startColumn, int endColumn)
+{
+	const float* cameraX = columns.CameraX.data();
+
+	for (int i = startColumn; i < endColumn; i++)
+	{
+		RayResult& ray = rays[i];
+
+		ray.Directon.x = camera.Facing.x + camera.Plane.x * cameraX[i];
+		ray.Directon.y = camera.Facing.y + camera.Plane.y * cameraX[i];
+	}
+
+	// walk all the rays, several at a time
+	CastRays(camera.Position, rays + startColumn, size_t(endColumn - startColumn));
+}
+
+// multiply a color by a tint, the same way the GPU does
+static inline Color Modulate(Color color, Color tint)
+{
+	return Color{ uint8_t((color.r * tint.r) / 255), uint8_t((color.g * tint.g) / 255), uint8_t((color.b * tint.b) / 255), color.a };
+}
+
+// alpha blend a color over what is already in the frame buffer
+static inline Color Blend(Color source, Color dest)
+{
+	int alpha = source.a;
+	int inverse = 255 - alpha;
+
+	return Color{ uint8_t((source.r * alpha + dest.r * inverse) / 255), uint8_t((source.g * alpha + dest.g * inverse) / 255), uint8_t((source.b * alpha + dest.b * inverse) / 255), 255 };
+}
+
+// the rows a wall at a distance covers. Walls stand on the floor, so a short wall keeps the bottom of a full wall
+// and loses rows off the top. The unclipped top of a full height wall is returned for the texture mapping
+static inline void GetWallRows(int frameHeight, float distance, uint8_t height, int& lineHeight, int& fullTop, int& top, int& bottom)
+{
+	int middle = frameHeight / 2;
+
+	// use the distance to compute how high the wall will be
+	lineHeight = (int)(frameHeight / distance);
+	fullTop = middle - lineHeight / 2;
+
+	int wallBottom = middle + lineHeight / 2;
+	int wallTop = fullTop;
+	if (height < FullWallHeight)
+		wallTop = wallBottom - (lineHeight * height) / FullWallHeight;
+
+	top = std::max(wallTop, 0);
+	bottom = std::min(wallBottom, frameHeight);
+}
+
+// the textures and sizes needed to map walls
+struct WallTextures
+{
+	const SoftwareTexture* Walls = nullptr;
+	int TexSize = 0;
+	int TextureCount = 0;
+};
+
+// find the span and texture mapping for one wall hit in a column
+static void SetupWallColumn(WallColumn& column, int frameHeight, const WallTextures& textures, float distance, float u, HitNormals normal, uint8_t type, uint8_t height)
+{
+	int lineHeight = 0;
+	int fullTop = 0;
+	GetWallRows(frameHeight, distance, height, lineHeight, fullTop, column.Top, column.Bottom);
+
+	// get our tint based on what side of a grid the ray hit
+	column.Tint = WallColors[uint8_t(normal)];
+	column.Texels = nullptr;
+
+	int texSize = textures.TexSize;
+	if (textures.Walls == nullptr || type == 0 || type > textures.TextureCount || lineHeight <= 0)
+		return;
+
+	// use the U coordinate of this ray (where on the texture it hits in x), and find the texture for this grid type
+	int texX = std::min(int(u * texSize), texSize - 1);
+	column.Texels = textures.Walls->GetColumn((type - 1) * texSize + texX);
+
+	// V goes from 0 to the texture size over the unclipped height of a full wall
+	column.TexStep = texSize / float(lineHeight);
+	column.TexV = -fullTop * column.TexStep;
+}
+
+// fill the pixel of a wall column on a row, if the column covers it
+static inline void DrawWallPixel(Color& pixel, const WallColumn& column, int y, int texSize)
+{
+	if (y < column.Top || y >= column.Bottom)
+		return;
+
+	if (column.Texels == nullptr)
+		pixel = column.Tint;
+	else
+		pixel = Modulate(column.Texels[std::min(int(column.TexV + y * column.TexStep), texSize - 1)], column.Tint);
+}
+
+// how a row of floor or ceiling maps to the world
+struct FloorRow
+{
+	// the texture to sample, or null for a flat color
+	const Color* Texels = nullptr;
+	Color FlatColor = BLANK;
+
+	// the world position under view column 0 and how much it moves per column
+	Vector2 Start = { 0 };
+	Vector2 Step = { 0 };
+};
+
+// the texel index in a square column-major texture for a world position
+static inline int GetFloorTexel(float x, float y, int texSize)
+{
+	float u = std::min((x - floorf(x)) * texSize, texSize - 1.0f);
+	float v = std::min((y - floorf(y)) * texSize, texSize - 1.0f);
+
+	return int(u) * texSize + int(v);
+}
+
+// fill a row of pixels with floor or ceiling texels, starting at a view column
+// every column is computed from the start of the view row, not accumulated or offset by the band, so the SIMD and scalar
+// loops and any split of the view into bands give the same texels
+static void DrawFloorRow(Color* row, int startColumn, int count, const FloorRow& floorRow, int texSize)
+{
+	if (floorRow.Texels == nullptr)
+	{
+		std::fill(row, row + count, floorRow.FlatColor);
+		return;
+	}
+
+	int i = 0;
+
+#ifdef RAYCAST_USE_SSE2
+	const __m128 startX = _mm_set1_ps(floorRow.Start.x);
+	const __m128 startY = _mm_set1_ps(floorRow.Start.y);
+	const __m128 stepX = _mm_set1_ps(floorRow.Step.x);
+	const __m128 stepY = _mm_set1_ps(floorRow.Step.y);
+	const __m128 size = _mm_set1_ps(float(texSize));
+	const __m128 maxTexel = _mm_set1_ps(texSize - 1.0f);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128i stride = _mm_set1_epi32(texSize);
+
+	__m128 column = _mm_add_ps(_mm_set1_ps(float(startColumn)), _mm_setr_ps(0, 1, 2, 3));
+	const __m128 four = _mm_set1_ps(4);
+
+	alignas(16) int32_t indexes[4];
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_add_ps(startX, _mm_mul_ps(stepX, column));
+		__m128 y = _mm_add_ps(startY, _mm_mul_ps(stepY, column));
+		column = _mm_add_ps(column, four);
+
+		// floor is a truncate that steps down when the truncate rounded up
+		__m128 truncX = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+		__m128 truncY = _mm_cvtepi32_ps(_mm_cvttps_epi32(y));
+		__m128 floorX = _mm_sub_ps(truncX, _mm_and_ps(_mm_cmpgt_ps(truncX, x), one));
+		__m128 floorY = _mm_sub_ps(truncY, _mm_and_ps(_mm_cmpgt_ps(truncY, y), one));
+
+		__m128i u = _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(_mm_sub_ps(x, floorX), size), maxTexel));
+		__m128i v = _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(_mm_sub_ps(y, floorY), size), maxTexel));
+
+		// u * stride, SSE2 has no 32 bit multiply but both values are small so a 16 bit multiply is exact
+		__m128i index = _mm_add_epi32(_mm_madd_epi16(u, stride), v);
+		_mm_store_si128((__m128i*)indexes, index);
+
+		row[i + 0] = floorRow.Texels[indexes[0]];
+		row[i + 1] = floorRow.Texels[indexes[1]];
+		row[i + 2] = floorRow.Texels[indexes[2]];
+		row[i + 3] = floorRow.Texels[indexes[3]];
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		float x = floorRow.Start.x + floorRow.Step.x * float(startColumn + i);
+		float y = floorRow.Start.y + floorRow.Step.y * float(startColumn + i);
+
+		row[i] = floorRow.Texels[GetFloorTexel(x, y, texSize)];
+	}
+}
+
+// draw the visible objects that overlap a range of columns, back to front and clipped by the wall distances
+static void DrawObjectColumns(FrameBuffer& frame, const SoftwareScene& scene, const RayResult* rays, int startColumn, int endColumn)
+{
+	const SoftwareTexture& sprite = *scene.Sprite;
+
+	int frameSize = sprite.Height;
+	int frameCount = sprite.Width / frameSize;
+	if (frameCount <= 0)
+		return;
+
+	for (size_t spanIndex = 0; spanIndex < scene.ObjectCount; spanIndex++)
+	{
+		const ObjectSpan& span = scene.Objects[spanIndex];
+
+		int drawStartX = std::max(span.StartColumn, startColumn);
+		int drawEndX = std::min(span.EndColumn, endColumn);
+		if (drawStartX >= drawEndX || span.Frame >= frameCount)
+			continue;
+
+		int drawStartY = std::max(span.Top, 0);
+		int drawEndY = std::min(span.Top + span.Size, frame.Height);
+
+		float texStep = frameSize / float(span.Size);
+
+		//loop through every vertical stripe of the sprite in our columns
+		for (int stripe = drawStartX; stripe < drawEndX; stripe++)
+		{
+			// the ray distances are our depth buffer, rays that missed are infinitely far away
+			float wallDistance = rays[stripe].Distance;
+			if (wallDistance >= 0 && span.Depth >= wallDistance)
+				continue;
+
+			// short walls in front of the object hide the rows they cover
+			int hiddenTop[MaxRayLayers];
+			int hiddenBottom[MaxRayLayers];
+			int hiddenCount = 0;
+
+			for (uint8_t layer = 0; layer < rays[stripe].LayerCount; layer++)
+			{
+				const RayLayer& wall = rays[stripe].Layers[layer];
+				if (wall.Distance > span.Depth)
+					break;
+
+				int lineHeight = 0;
+				int fullTop = 0;
+				GetWallRows(frame.Height, wall.Distance, wall.Height, lineHeight, fullTop, hiddenTop[hiddenCount], hiddenBottom[hiddenCount]);
+				hiddenCount++;
+			}
+
+			int texX = std::min(int((stripe - span.Left) * texStep), frameSize - 1);
+			const Color* texels = sprite.GetColumn(span.Frame * frameSize + texX);
+
+			for (int y = drawStartY; y < drawEndY; y++)
+			{
+				bool hidden = false;
+				for (int layer = 0; layer < hiddenCount; layer++)
+					hidden |= y >= hiddenTop[layer] && y < hiddenBottom[layer];
+
+				if (hidden)
+					continue;
+
+				int texY = std::min(int((y - span.Top) * texStep), frameSize - 1);
+				Color texel = texels[texY];
+
+				if (texel.a == 0)
+					continue;
+
+				Color& pixel = frame.GetRow(y)[stripe];
+				pixel = texel.a == 255 ? texel : Blend(texel, pixel);
+			}
+		}
+	}
+}
+
+void DrawViewColumns(FrameBuffer& frame, ViewWallColumns& wallColumns, const RaycastCamera& camera, const SoftwareScene& scene, const RayResult* rays, int startColumn, int endColumn)
+{
+	int columnCount = endColumn - startColumn;
+	if (columnCount <= 0)
+		return;
+
+	// the middle of the screen
+	int middle = frame.Height / 2;
+
+	bool textured = !scene.FlatShaded && scene.Walls != nullptr && scene.Walls->Height > 0;
+
+	WallTextures textures;
+	if (textured)
+	{
+		textures.Walls = scene.Walls;
+		textures.TexSize = scene.Walls->Height;
+		textures.TextureCount = scene.Walls->Width / textures.TexSize;
+	}
+
+	int texSize = textures.TexSize;
+	int textureCount = textures.TextureCount;
+
+	// find the span and texture mapping of each wall column first, so that the pixels can be filled a row at a time
+	// the short walls each column sees over get their own columns, MaxRayLayers per view column
+	WallColumn* columns = wallColumns.Walls.data() + startColumn;
+	WallColumn* layers = wallColumns.Layers.data() + size_t(startColumn) * MaxRayLayers;
+	uint8_t* layerCounts = wallColumns.LayerCounts.data() + startColumn;
+	bool anyLayers = false;
+
+	for (int i = 0; i < columnCount; i++)
+	{
+		const RayResult& ray = rays[startColumn + i];
+
+		if (ray.Distance < 0)
+			columns[i].Top = columns[i].Bottom = middle;
+		else
+			SetupWallColumn(columns[i], frame.Height, textures, ray.Distance, ray.U, ray.Normal, ray.HitGridType, FullWallHeight);
+
+		layerCounts[i] = ray.LayerCount;
+		if (ray.LayerCount == 0)
+			continue;
+
+		anyLayers = true;
+		for (uint8_t layer = 0; layer < ray.LayerCount; layer++)
+		{
+			const RayLayer& wall = ray.Layers[layer];
+			SetupWallColumn(layers[size_t(i) * MaxRayLayers + layer], frame.Height, textures, wall.Distance, wall.U, wall.Normal, wall.HitGridType, wall.Height);
+		}
+	}
+
+	// the floor and ceiling rays at the left and right edges of the view, the same as the first and last columns
+	Vector2 leftRay = Vector2Subtract(camera.Facing, camera.Plane);
+	Vector2 rayStep = Vector2Scale(camera.Plane, 2.0f / frame.Width);
+
+	const Color* floorTexels = nullptr;
+	const Color* ceilingTexels = nullptr;
+
+	if (textured && scene.FloorTexture >= 0 && scene.FloorTexture < textureCount)
+		floorTexels = scene.Walls->GetColumn(scene.FloorTexture * texSize);
+
+	if (textured && scene.CeilingTexture >= 0 && scene.CeilingTexture < textureCount)
+		ceilingTexels = scene.Walls->GetColumn(scene.CeilingTexture * texSize);
+
+	// fill the rows, each row of this column range is contiguous in memory
+	for (int y = 0; y < frame.Height; y++)
+	{
+		Color* row = frame.GetRow(y) + startColumn;
+
+		// the floor and ceiling are drawn under the whole row first, then the walls are drawn over them
+		FloorRow floorRow;
+		if (y < middle)
+		{
+			floorRow.Texels = ceilingTexels;
+			floorRow.FlatColor = CeilingColor;
+		}
+		else
+		{
+			floorRow.Texels = floorTexels;
+			floorRow.FlatColor = FloorColor;
+		}
+
+		if (floorRow.Texels != nullptr)
+		{
+			// the distance to the floor (or ceiling) seen through the center of this row
+			// the camera is half way between the floor and ceiling, the same height used to size the walls
+			float rowDistance = (0.5f * frame.Height) / (fabsf(y - middle + 0.5f));
+
+			floorRow.Start = Vector2Add(camera.Position, Vector2Scale(leftRay, rowDistance));
+			floorRow.Step = Vector2Scale(rayStep, rowDistance);
+		}
+
+		DrawFloorRow(row, startColumn, columnCount, floorRow, texSize);
+
+		for (int i = 0; i < columnCount; i++)
+			DrawWallPixel(row[i], columns[i], y, texSize);
+
+		if (!anyLayers)
+			continue;
+
+		// short walls are drawn back to front over the wall behind them
+		for (int i = 0; i < columnCount; i++)
+		{
+			for (int layer = layerCounts[i] - 1; layer >= 0; layer--)
+				DrawWallPixel(row[i], layers[size_t(i) * MaxRayLayers + layer], y, texSize);
+		}
+	}
+
+	if (scene.Sprite != nullptr && scene.Sprite->Height > 0)
+		DrawObjectColumns(frame, scene, rays, startColumn, endColumn);
+}
+
+bool ExportFrameBuffer(const FrameBuffer& frame, const char* fileName)
+{
+	Image image = { 0 };
+	image.data = (void*)frame.Pixels.data();
+	image.width = frame.Width;
+	image.height = frame.Height;
+	image.mipmaps = 1;
+	image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+	return ExportImage(image, fileName);
+}
@@ -42,6 +42,14 @@ struct PlayerInfo
     static constexpr float ReloadTime = 0.1f;
     static constexpr float RecoilDistance = -0.125f;
 
+    // the camera is kept this far away from walls
+    static constexpr float CameraRadius = 0.25f;
+    // how far ahead in seconds the player's movement is used to pull the camera in before a wall gets between them
+    static constexpr float CameraLookAhead = 0.2f;
+    // how quickly the camera moves in toward a wall, and back out once it is clear
+    static constexpr float CameraPullInRate = 20.0f;
+    static constexpr float CameraEaseOutRate = 4.0f;
+
     ObjectTransform PlayerNode;
     ObjectTransform CameraNode;
     ObjectTransform PivotNode;
@@ -53,6 +61,7 @@ struct PlayerInfo
     float TitltAngle = 0;
 
     float DesiredPullback = 10;
+    float CameraDistance = 10;
 
     Vector3 DesiredMovement = { 0 };
 
@@ -76,5 +85,8 @@ struct PlayerInfo
 
     void Update(Map& map);
 
+    // sphere cast the camera back from the pivot and ease it toward the distance it can have
+    void UpdateCamera(Map& map, Vector3 movement, float deltaTime);
+
     void Draw();
 };
\ No newline at end of file
@@ -51,6 +51,9 @@ void GameInit(Map &map)
 
     BuildDemoMap(map);
 
+    // the third person camera needs to stop at the ground
+    map.FloorCollisions = true;
+
     map.Setup();
     Player.Setup();
 }
@@ -66,6 +69,7 @@ void GameCleanup(Map& map)
 bool GameUpdate(Map& map)
 {
     Player.Update(map);
+    map.Update(GetFrameTime());
 
     return true;
 }
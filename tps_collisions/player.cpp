@@ -30,6 +30,8 @@
 #include "map.h"
 #include "raymath.h"
 
+#include <algorithm>
+
 Model GunMesh = { 0 };
 
 void PlayerInfo::SetupGraphics()
@@ -149,42 +151,22 @@ void PlayerInfo::Update(Map& map)
     Vector3 oldPos = PlayerNode.GetPosition();
     Vector3 newWorldPos = Vector3Add(oldPos, DesiredMovement);
 
-    HitLastFrame = map.CollidePlayer(newWorldPos, oldPos, CollisionRadius, 2);
+    HitLastFrame = map.MovePlayer(newWorldPos, oldPos, CollisionRadius, 2);
 
     // set the player to where they can be
     PlayerNode.SetPosition(newWorldPos);
 
-    // see if the camera collides with anything
-	Vector3 cameraRoot = PivotNode.GetWorldPosition();
-    CameraNode.SetD(-DesiredPullback);
-
-	Vector3 cameraPos = CameraNode.GetWorldPosition();
-
-    Ray camRay = { 0 };
-    camRay.position = cameraRoot;
-    camRay.direction = Vector3Normalize(cameraPos - cameraRoot);
-
-    LastCameraCollision = { 0 };
-
-    map.CollideRay(camRay, LastCameraCollision, nullptr, 0.25f);
-
-    if (LastCameraCollision.hit)
-    {
-		if (LastCameraCollision.distance < DesiredPullback)
-		{
-			CameraNode.SetD(-(LastCameraCollision.distance - 0.25f));
-		}
-    }
+    UpdateCamera(map, Vector3Subtract(newWorldPos, oldPos), GetFrameTime());
 
     // update the camera with the new view.
     CameraNode.SetCamera(ViewCamera);
 
     // raycast from the view into the world to see what it would hit
     Ray gunRay = { 0 };
-    gunRay.position = Vector3Transform(Vector3Zero(), CameraNode.GetWorldMatrix());
-    gunRay.direction = Vector3Subtract(Vector3Transform(Vector3{ 0,0,1 }, CameraNode.GetWorldMatrix()), gunRay.position);
+    gunRay.position = CameraNode.GetWorldPosition();
+    gunRay.direction = CameraNode.GetWorldDVector();
 
-    map.CollideRay(gunRay, LastGunCollision);   // optional, if you need to know what you hit, you can pass a pointer in here that will be set with the wall that is hit
+    map.CollideRay(gunRay, LastGunCollision);   // optional, if you need to know what you hit, you can pass the address of an Obstacle pointer in here that will be set to the wall that is hit
 
     // handle shooting
     Reload -= GetFrameTime();  // decrement reload wait time
@@ -211,6 +193,47 @@ void PlayerInfo::Update(Map& map)
     GunNode.SetD(param * RecoilDistance + GunDefaultD);
 }
 
+void PlayerInfo::UpdateCamera(Map& map, Vector3 movement, float deltaTime)
+{
+    Vector3 cameraRoot = PivotNode.GetWorldPosition();
+
+    // the camera is pulled straight back from the pivot
+    Vector3 backDirection = Vector3Negate(PivotNode.GetWorldDVector());
+
+    // see how far back the camera can go from where the player is now
+    Ray camRay = { cameraRoot, backDirection };
+    float allowedNow = DesiredPullback;
+    if (map.SphereCast(camRay, CameraRadius, DesiredPullback, LastCameraCollision))
+        allowedNow = LastCameraCollision.distance;
+
+    HitCameraLastFrame = LastCameraCollision.hit;
+
+    // see how far back it could go from where the player will be soon, so it starts moving in before a wall gets in the way
+    // the look ahead stops at walls, the player can't get past them either
+    float target = allowedNow;
+    float lookAhead = Vector3Length(movement) * CameraLookAhead / std::max(deltaTime, 0.0001f);
+    if (lookAhead > 0 && allowedNow > 0)
+    {
+        Ray aheadRay = { cameraRoot, Vector3Normalize(movement) };
+        RayCollision aheadCollision = { 0 };
+        map.SphereCast(aheadRay, CameraRadius, lookAhead, aheadCollision);
+
+        Ray predictedRay = { aheadCollision.point, backDirection };
+        RayCollision predictedCollision = { 0 };
+        if (map.SphereCast(predictedRay, CameraRadius, DesiredPullback, predictedCollision))
+            target = std::min(target, predictedCollision.distance);
+    }
+
+    // ease toward the target, quickly when moving in and slowly when moving back out
+    float rate = target < CameraDistance ? CameraPullInRate : CameraEaseOutRate;
+    CameraDistance += (target - CameraDistance) * (1 - expf(-rate * deltaTime));
+
+    // the easing never leaves the camera behind a wall that is in the way right now
+    CameraDistance = std::min(CameraDistance, allowedNow);
+
+    CameraNode.SetD(-CameraDistance);
+}
+
 void PlayerInfo::Draw()
 {
     PlayerNode.PushMatrix();